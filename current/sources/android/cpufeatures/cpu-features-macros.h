@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef CPU_FEATURES_MACROS_H
+#define CPU_FEATURES_MACROS_H
+
+#include "cpu-features.h"
+
+/* Compile-time companions to the runtime feature bits in cpu-features.h.
+ *
+ * For each runtime ANDROID_CPU_*_FEATURE_* bit of the current target
+ * there is an ANDROID_CPU_COMPILE_TIME_* macro that is 1 when the build
+ * flags (-march/-mfpu/etc., surfaced through the ACLE and x86 built-in
+ * macros) already guarantee the feature, and 0 otherwise.  The
+ * guaranteed bits are also OR'd into ANDROID_CPU_COMPILE_TIME_FEATURES
+ * (and ..._FEATURES_EX for the arm64 extension bits), so dispatch code
+ * can skip the runtime query for variants the build targets anyway:
+ *
+ *     if (ANDROID_CPU_COMPILE_TIME_NEON ||
+ *         (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON))
+ *         ...
+ *
+ * Keep the mappings in sync with the enums in cpu-features.h; each bit
+ * defined there should have a macro here for its architecture.
+ */
+
+#if defined(__arm__)
+
+#if defined(__ARM_ARCH) && __ARM_ARCH >= 7
+#define ANDROID_CPU_COMPILE_TIME_ARMv7 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_ARMv7 0
+#endif
+
+/* __ARM_FP is defined whenever the target has hardware floating point;
+ * on ARMv7 targets that means VFPv3 or better.  Bit 1 of __ARM_FP is
+ * half-precision support.
+ */
+#if defined(__ARM_FP)
+#define ANDROID_CPU_COMPILE_TIME_VFPv2 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_VFPv2 0
+#endif
+
+#if defined(__ARM_FP) && ANDROID_CPU_COMPILE_TIME_ARMv7
+#define ANDROID_CPU_COMPILE_TIME_VFPv3 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_VFPv3 0
+#endif
+
+#if defined(__ARM_FP) && (__ARM_FP & 0x2)
+#define ANDROID_CPU_COMPILE_TIME_VFP_FP16 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_VFP_FP16 0
+#endif
+
+#if defined(__ARM_FEATURE_FMA)
+#define ANDROID_CPU_COMPILE_TIME_VFP_FMA 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_VFP_FMA 0
+#endif
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define ANDROID_CPU_COMPILE_TIME_NEON 1
+/* NEON requires the 32 x D-register file. */
+#define ANDROID_CPU_COMPILE_TIME_VFP_D32 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_NEON 0
+#define ANDROID_CPU_COMPILE_TIME_VFP_D32 0
+#endif
+
+#if ANDROID_CPU_COMPILE_TIME_NEON && ANDROID_CPU_COMPILE_TIME_VFP_FMA
+#define ANDROID_CPU_COMPILE_TIME_NEON_FMA 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_NEON_FMA 0
+#endif
+
+#if defined(__ARM_ARCH) && __ARM_ARCH >= 6
+#define ANDROID_CPU_COMPILE_TIME_LDREX_STREX 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_LDREX_STREX 0
+#endif
+
+/* __ARM_FEATURE_IDIV describes the instruction set currently being
+ * compiled for, so map it to the matching runtime bit only.
+ */
+#if defined(__ARM_FEATURE_IDIV) && !defined(__thumb__)
+#define ANDROID_CPU_COMPILE_TIME_IDIV_ARM 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_IDIV_ARM 0
+#endif
+
+#if defined(__ARM_FEATURE_IDIV) && defined(__thumb__)
+#define ANDROID_CPU_COMPILE_TIME_IDIV_THUMB2 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_IDIV_THUMB2 0
+#endif
+
+#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+#define ANDROID_CPU_COMPILE_TIME_AES 1
+#define ANDROID_CPU_COMPILE_TIME_PMULL 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_AES 0
+#define ANDROID_CPU_COMPILE_TIME_PMULL 0
+#endif
+
+#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2)
+#define ANDROID_CPU_COMPILE_TIME_SHA1 1
+#define ANDROID_CPU_COMPILE_TIME_SHA2 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SHA1 0
+#define ANDROID_CPU_COMPILE_TIME_SHA2 0
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#define ANDROID_CPU_COMPILE_TIME_CRC32 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_CRC32 0
+#endif
+
+#define ANDROID_CPU_COMPILE_TIME_FEATURES \
+  ((ANDROID_CPU_COMPILE_TIME_ARMv7 ? ANDROID_CPU_ARM_FEATURE_ARMv7 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_VFPv3 ? ANDROID_CPU_ARM_FEATURE_VFPv3 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_NEON ? ANDROID_CPU_ARM_FEATURE_NEON : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_LDREX_STREX ? ANDROID_CPU_ARM_FEATURE_LDREX_STREX : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_VFPv2 ? ANDROID_CPU_ARM_FEATURE_VFPv2 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_VFP_D32 ? ANDROID_CPU_ARM_FEATURE_VFP_D32 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_VFP_FP16 ? ANDROID_CPU_ARM_FEATURE_VFP_FP16 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_VFP_FMA ? ANDROID_CPU_ARM_FEATURE_VFP_FMA : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_NEON_FMA ? ANDROID_CPU_ARM_FEATURE_NEON_FMA : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_IDIV_ARM ? ANDROID_CPU_ARM_FEATURE_IDIV_ARM : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_IDIV_THUMB2 ? ANDROID_CPU_ARM_FEATURE_IDIV_THUMB2 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_AES ? ANDROID_CPU_ARM_FEATURE_AES : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_PMULL ? ANDROID_CPU_ARM_FEATURE_PMULL : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SHA1 ? ANDROID_CPU_ARM_FEATURE_SHA1 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SHA2 ? ANDROID_CPU_ARM_FEATURE_SHA2 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_CRC32 ? ANDROID_CPU_ARM_FEATURE_CRC32 : 0))
+
+#define ANDROID_CPU_COMPILE_TIME_FEATURES_EX 0
+
+#elif defined(__aarch64__)
+
+/* FP and Advanced SIMD are architectural baseline on arm64. */
+#define ANDROID_CPU_COMPILE_TIME_FP 1
+#define ANDROID_CPU_COMPILE_TIME_ASIMD 1
+
+#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+#define ANDROID_CPU_COMPILE_TIME_AES 1
+#define ANDROID_CPU_COMPILE_TIME_PMULL 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_AES 0
+#define ANDROID_CPU_COMPILE_TIME_PMULL 0
+#endif
+
+#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2)
+#define ANDROID_CPU_COMPILE_TIME_SHA1 1
+#define ANDROID_CPU_COMPILE_TIME_SHA2 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SHA1 0
+#define ANDROID_CPU_COMPILE_TIME_SHA2 0
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#define ANDROID_CPU_COMPILE_TIME_CRC32 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_CRC32 0
+#endif
+
+/* Extension bits reported by android_getCpuFeaturesEx(). */
+#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+#define ANDROID_CPU_COMPILE_TIME_FP16 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_FP16 0
+#endif
+
+#if defined(__ARM_FEATURE_ATOMICS)
+#define ANDROID_CPU_COMPILE_TIME_LSE 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_LSE 0
+#endif
+
+#if defined(__ARM_FEATURE_DOTPROD)
+#define ANDROID_CPU_COMPILE_TIME_DOTPROD 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_DOTPROD 0
+#endif
+
+#if defined(__ARM_FEATURE_SVE)
+#define ANDROID_CPU_COMPILE_TIME_SVE 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SVE 0
+#endif
+
+#if defined(__ARM_FEATURE_SVE2)
+#define ANDROID_CPU_COMPILE_TIME_SVE2 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SVE2 0
+#endif
+
+#if defined(__ARM_FEATURE_MATMUL_INT8)
+#define ANDROID_CPU_COMPILE_TIME_I8MM 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_I8MM 0
+#endif
+
+#if defined(__ARM_FEATURE_BF16_VECTOR_ARITHMETIC)
+#define ANDROID_CPU_COMPILE_TIME_BF16 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_BF16 0
+#endif
+
+#define ANDROID_CPU_COMPILE_TIME_FEATURES \
+  (ANDROID_CPU_ARM64_FEATURE_FP | \
+   ANDROID_CPU_ARM64_FEATURE_ASIMD | \
+   (ANDROID_CPU_COMPILE_TIME_AES ? ANDROID_CPU_ARM64_FEATURE_AES : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_PMULL ? ANDROID_CPU_ARM64_FEATURE_PMULL : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SHA1 ? ANDROID_CPU_ARM64_FEATURE_SHA1 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SHA2 ? ANDROID_CPU_ARM64_FEATURE_SHA2 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_CRC32 ? ANDROID_CPU_ARM64_FEATURE_CRC32 : 0))
+
+#define ANDROID_CPU_COMPILE_TIME_FEATURES_EX \
+  ((ANDROID_CPU_COMPILE_TIME_FP16 ? ANDROID_CPU_ARM64_FEATURE_FP16 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_LSE ? ANDROID_CPU_ARM64_FEATURE_LSE : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_DOTPROD ? ANDROID_CPU_ARM64_FEATURE_DOTPROD : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SVE ? ANDROID_CPU_ARM64_FEATURE_SVE : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SVE2 ? ANDROID_CPU_ARM64_FEATURE_SVE2 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_I8MM ? ANDROID_CPU_ARM64_FEATURE_I8MM : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_BF16 ? ANDROID_CPU_ARM64_FEATURE_BF16 : 0))
+
+#elif defined(__i386__) || defined(__x86_64__)
+
+#if defined(__SSSE3__)
+#define ANDROID_CPU_COMPILE_TIME_SSSE3 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SSSE3 0
+#endif
+
+#if defined(__POPCNT__)
+#define ANDROID_CPU_COMPILE_TIME_POPCNT 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_POPCNT 0
+#endif
+
+#if defined(__MOVBE__)
+#define ANDROID_CPU_COMPILE_TIME_MOVBE 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_MOVBE 0
+#endif
+
+#if defined(__SSE4_1__)
+#define ANDROID_CPU_COMPILE_TIME_SSE4_1 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SSE4_1 0
+#endif
+
+#if defined(__SSE4_2__)
+#define ANDROID_CPU_COMPILE_TIME_SSE4_2 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SSE4_2 0
+#endif
+
+#if defined(__AES__)
+#define ANDROID_CPU_COMPILE_TIME_AES_NI 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_AES_NI 0
+#endif
+
+#if defined(__AVX__)
+#define ANDROID_CPU_COMPILE_TIME_AVX 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_AVX 0
+#endif
+
+#if defined(__RDRND__)
+#define ANDROID_CPU_COMPILE_TIME_RDRAND 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_RDRAND 0
+#endif
+
+#if defined(__AVX2__)
+#define ANDROID_CPU_COMPILE_TIME_AVX2 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_AVX2 0
+#endif
+
+#if defined(__SHA__)
+#define ANDROID_CPU_COMPILE_TIME_SHA_NI 1
+#else
+#define ANDROID_CPU_COMPILE_TIME_SHA_NI 0
+#endif
+
+#define ANDROID_CPU_COMPILE_TIME_FEATURES \
+  ((ANDROID_CPU_COMPILE_TIME_SSSE3 ? ANDROID_CPU_X86_FEATURE_SSSE3 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_POPCNT ? ANDROID_CPU_X86_FEATURE_POPCNT : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_MOVBE ? ANDROID_CPU_X86_FEATURE_MOVBE : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SSE4_1 ? ANDROID_CPU_X86_FEATURE_SSE4_1 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SSE4_2 ? ANDROID_CPU_X86_FEATURE_SSE4_2 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_AES_NI ? ANDROID_CPU_X86_FEATURE_AES_NI : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_AVX ? ANDROID_CPU_X86_FEATURE_AVX : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_RDRAND ? ANDROID_CPU_X86_FEATURE_RDRAND : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_AVX2 ? ANDROID_CPU_X86_FEATURE_AVX2 : 0) | \
+   (ANDROID_CPU_COMPILE_TIME_SHA_NI ? ANDROID_CPU_X86_FEATURE_SHA_NI : 0))
+
+#define ANDROID_CPU_COMPILE_TIME_FEATURES_EX 0
+
+#else  /* mips / unknown */
+
+#define ANDROID_CPU_COMPILE_TIME_FEATURES 0
+#define ANDROID_CPU_COMPILE_TIME_FEATURES_EX 0
+
+#endif
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+
+/* Constexpr traits for template kernels: instantiate a variant only
+ * when it can run somewhere, and skip the runtime query entirely when
+ * the build flags already guarantee it.
+ */
+namespace android_cpu {
+
+constexpr uint64_t kCompileTimeFeatures = ANDROID_CPU_COMPILE_TIME_FEATURES;
+constexpr uint64_t kCompileTimeFeaturesEx =
+    ANDROID_CPU_COMPILE_TIME_FEATURES_EX;
+
+/* True when the build flags guarantee every bit in kBits. */
+template <uint64_t kBits>
+constexpr bool has_compile_time() {
+    return (kCompileTimeFeatures & kBits) == kBits;
+}
+
+template <uint64_t kBits>
+constexpr bool has_compile_time_ex() {
+    return (kCompileTimeFeaturesEx & kBits) == kBits;
+}
+
+/* True when every bit in kBits is available, checking the runtime
+ * flags only for bits the build does not guarantee.  The compile-time
+ * branch folds to a constant true where possible.
+ */
+template <uint64_t kBits>
+inline bool has() {
+    return has_compile_time<kBits>() ||
+           (android_getCpuFeatures() & kBits) == kBits;
+}
+
+template <uint64_t kBits>
+inline bool has_ex() {
+    return has_compile_time_ex<kBits>() ||
+           (android_getCpuFeaturesEx() & kBits) == kBits;
+}
+
+}  // namespace android_cpu
+
+#endif  /* __cplusplus >= 201103L */
+
+#endif /* CPU_FEATURES_MACROS_H */
@@ -27,6 +27,39 @@
  */
 
 /* ChangeLog for this library:
+ *
+ * NDK r22: Make android_setCpu()/android_setCpuArm() thread-safe and
+ *          callable at any time, including after first init and more
+ *          than once. The override is published as one atomic pointer
+ *          so readers never see a torn {count, features, cpuid} set.
+ *
+ * NDK r22: Add android_getCurrentCpu(), android_getCpuCoreType() and
+ *          android_getCurrentCpuCacheInfo() so migration-aware code
+ *          can re-pick per-core parameters cheaply.
+ *
+ * NDK r22: Add android_cpuResolve(), a cached resolver that selects
+ *          an implementation variant from required feature masks.
+ *
+ * NDK r22: Add android_getCpuCountOnline(), a cheap hotplug-aware
+ *          online core count.
+ *
+ * NDK r22: Add android_getCpuClusterCount()/android_getCpuClusterInfo()
+ *          and android_getCpuMaxFreqKHz() to expose big.LITTLE cluster
+ *          topology.
+ *
+ * NDK r22: Add android_getCpuCacheInfo() to report per-core cache line
+ *          and L1/L2/L3 sizes from sysfs.
+ *
+ * NDK r22: Add android_getCpuFeaturesEx() and the extended ARM64
+ *          feature bits for the ARMv8.x extensions (FP16, LSE,
+ *          DOTPROD, SVE/SVE2, I8MM, BF16).
+ *
+ * NDK r22: Source the feature bits and core count from getauxval() and
+ *          sysconf() when the kernel provides them, so that first-call
+ *          initialization no longer reads /proc/cpuinfo on modern
+ *          devices. The /proc/cpuinfo parser is kept as a fallback for
+ *          old kernels and for the fields the aux vector cannot provide
+ *          (e.g. the ARM CPUID).
  *
  * NDK r10e?: Add MIPS MSA feature.
  *
@@ -67,23 +100,41 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/auxv.h>
 #include <sys/system_properties.h>
+#include <time.h>
 #include <unistd.h>
 
 static  pthread_once_t     g_once;
 static  int                g_inited;
 static  AndroidCpuFamily   g_cpuFamily;
 static  uint64_t           g_cpuFeatures;
+static  uint64_t           g_cpuFeaturesEx;
 static  int                g_cpuCount;
 
 #ifdef __arm__
 static  uint32_t           g_cpuIdArm;
 #endif
 
+/* An override installed by android_setCpu()/android_setCpuArm().
+ * The triple is published as a single pointer store so readers racing
+ * with an update always observe a consistent {count, features, cpuid}
+ * set, never a half-written one.
+ */
+typedef struct {
+    int      cpu_count;
+    uint64_t cpu_features;
+    uint64_t cpu_features_ex;
+    uint32_t cpu_id;
+    int      has_cpu_id;
+} AndroidCpuOverride;
+
+static AndroidCpuOverride* g_cpuOverride;
+
 static const int android_cpufeatures_debug = 0;
 
 #define  D(...) \
@@ -133,6 +184,7 @@ static __inline__ void x86_cpuid(int func, int values[4])
 }
 #endif
 
+#ifdef __arm__
 /* Get the size of a file by reading it until the end. This is needed
  * because files under /proc do not always return a valid size when
  * using fseek(0, SEEK_END) + ftell(). Nor can they be mmap()-ed.
@@ -166,6 +218,7 @@ get_file_size(const char* pathname)
     close(fd);
     return result;
 }
+#endif /* __arm__ */
 
 /* Read the content of /proc/cpuinfo into a user-provided buffer.
  * Return the length of the data, or -1 on error. Does *not*
@@ -450,6 +503,37 @@ cpulist_read_from(CpuList* list, const char* filename)
 
     cpulist_parse(list, file, filelen);
 }
+
+/* Read a small positive integer from a sysfs file. Handles the 'K' and
+ * 'M' suffixes used by the cache 'size' attributes. Return -1 on
+ * failure.
+ */
+static int
+read_sysfs_int(const char* filename)
+{
+    char   file[64];
+    int    filelen;
+    int    value = 0;
+    const char* p;
+
+    filelen = read_file(filename, file, sizeof file);
+    if (filelen < 0) {
+        D("Could not read %s: %s\n", filename, strerror(errno));
+        return -1;
+    }
+
+    p = parse_decimal(file, file + filelen, &value);
+    if (p == NULL)
+        return -1;
+
+    if (p < file + filelen) {
+        if (*p == 'K')
+            value *= 1024;
+        else if (*p == 'M')
+            value *= 1024*1024;
+    }
+    return value;
+}
 #if defined(__aarch64__)
 // see <uapi/asm/hwcap.h> kernel header
 #define HWCAP_FP                (1 << 0)
@@ -459,6 +543,15 @@ cpulist_read_from(CpuList* list, const char* filename)
 #define HWCAP_SHA1              (1 << 5)
 #define HWCAP_SHA2              (1 << 6)
 #define HWCAP_CRC32             (1 << 7)
+#define HWCAP_ATOMICS           (1 << 8)
+#define HWCAP_FPHP              (1 << 9)
+#define HWCAP_ASIMDHP           (1 << 10)
+#define HWCAP_ASIMDDP           (1 << 20)
+#define HWCAP_SVE               (1 << 22)
+
+#define HWCAP2_SVE2             (1 << 1)
+#define HWCAP2_I8MM             (1 << 13)
+#define HWCAP2_BF16             (1 << 14)
 #endif
 
 #if defined(__arm__)
@@ -527,6 +620,64 @@ get_elf_hwcap_from_proc_self_auxv(void) {
     return result;
 }
 
+/* Map a 'Features' token to the HWCAP flags it implies. Note that
+ * 'idiv' is how some kernels report support for both idiva and idivt.
+ */
+static const struct {
+    const char* name;
+    uint32_t    hwcaps;
+} cpu_feature_names[] = {
+    { "vfp",      HWCAP_VFP },
+    { "vfpv3",    HWCAP_VFPv3 },
+    { "vfpv3d16", HWCAP_VFPv3D16 },
+    { "vfpv4",    HWCAP_VFPv4 },
+    { "neon",     HWCAP_NEON },
+    { "idiva",    HWCAP_IDIVA },
+    { "idivt",    HWCAP_IDIVT },
+    { "idiv",     HWCAP_IDIVA | HWCAP_IDIVT },
+    { "iwmmxt",   HWCAP_IWMMXT },
+};
+
+/* Compute the HWCAP flags from a space-separated 'Features' list in a
+ * single pass: each token is looked up in cpu_feature_names[], so the
+ * cost is linear in the length of the line rather than one full scan
+ * per known feature as with has_list_item().
+ */
+static uint32_t
+get_elf_hwcap_from_features_list(const char* list)
+{
+    uint32_t hwcaps = 0;
+    const char* p = list;
+
+    while (*p) {
+        const char* q;
+        int len;
+        size_t n;
+
+        /* skip spaces */
+        while (*p == ' ' || *p == '\t')
+            p++;
+
+        /* find end of current list item */
+        q = p;
+        while (*q && *q != ' ' && *q != '\t')
+            q++;
+
+        len = q - p;
+        for (n = 0; n < sizeof(cpu_feature_names)/sizeof(cpu_feature_names[0]); n++) {
+            if ((int)strlen(cpu_feature_names[n].name) == len &&
+                !memcmp(p, cpu_feature_names[n].name, len)) {
+                hwcaps |= cpu_feature_names[n].hwcaps;
+                break;
+            }
+        }
+
+        /* skip to next item */
+        p = q;
+    }
+    return hwcaps;
+}
+
 /* Compute the ELF HWCAP flags from the content of /proc/cpuinfo.
  * This works by parsing the 'Features' line, which lists which optional
  * features the device's CPU supports, on top of its reference
@@ -555,29 +706,41 @@ get_elf_hwcap_from_proc_cpuinfo(const char* cpuinfo, int cpuinfo_len) {
     if (cpuFeatures != NULL) {
         D("Found cpuFeatures = '%s'\n", cpuFeatures);
 
-        if (has_list_item(cpuFeatures, "vfp"))
-            hwcaps |= HWCAP_VFP;
-        if (has_list_item(cpuFeatures, "vfpv3"))
-            hwcaps |= HWCAP_VFPv3;
-        if (has_list_item(cpuFeatures, "vfpv3d16"))
-            hwcaps |= HWCAP_VFPv3D16;
-        if (has_list_item(cpuFeatures, "vfpv4"))
-            hwcaps |= HWCAP_VFPv4;
-        if (has_list_item(cpuFeatures, "neon"))
-            hwcaps |= HWCAP_NEON;
-        if (has_list_item(cpuFeatures, "idiva"))
-            hwcaps |= HWCAP_IDIVA;
-        if (has_list_item(cpuFeatures, "idivt"))
-            hwcaps |= HWCAP_IDIVT;
-        if (has_list_item(cpuFeatures, "idiv"))
-            hwcaps |= HWCAP_IDIVA | HWCAP_IDIVT;
-        if (has_list_item(cpuFeatures, "iwmmxt"))
-            hwcaps |= HWCAP_IWMMXT;
+        hwcaps |= get_elf_hwcap_from_features_list(cpuFeatures);
 
         free(cpuFeatures);
     }
     return hwcaps;
 }
+
+/* Read all of /proc/cpuinfo into a heap-allocated buffer that must be
+ * freed by the caller. On success, return the length of the data and
+ * set '*cpuinfo' to the buffer. Return -1 on failure.
+ */
+static int
+load_proc_cpuinfo(char** cpuinfo)
+{
+    int cpuinfo_len = get_file_size("/proc/cpuinfo");
+    if (cpuinfo_len < 0) {
+        D("cpuinfo_len cannot be computed!");
+        return -1;
+    }
+    *cpuinfo = malloc(cpuinfo_len);
+    if (*cpuinfo == NULL) {
+        D("cpuinfo buffer could not be allocated");
+        return -1;
+    }
+    cpuinfo_len = read_file("/proc/cpuinfo", *cpuinfo, cpuinfo_len);
+    D("cpuinfo_len is (%d):\n%.*s\n", cpuinfo_len,
+      cpuinfo_len >= 0 ? cpuinfo_len : 0, *cpuinfo);
+
+    if (cpuinfo_len < 0) {  /* should not happen */
+        free(*cpuinfo);
+        *cpuinfo = NULL;
+        return -1;
+    }
+    return cpuinfo_len;
+}
 #endif  /* __arm__ */
 
 /* Return the number of cpus present on a given device.
@@ -619,119 +782,250 @@ android_cpuInitFamily(void)
 #endif
 }
 
+#ifdef __arm__
+static pthread_once_t g_cpuIdOnce;
+static int            g_cpuIsGoldfish;
+
+/* Recover the ARM CPUID from /proc/cpuinfo. The CPUID is the only value
+ * that the aux vector cannot provide, so this parse is kept out of the
+ * regular init path and only runs when the decoded features look
+ * suspicious, or lazily when android_getCpuIdArm() is actually called.
+ * Writes only g_cpuIdArm and g_cpuIsGoldfish: the CPUID-keyed feature
+ * fixups live in android_cpuApplyArmCpuIdFixups(), which must not run
+ * from the lazy path (see there).
+ */
 static void
-android_cpuInit(void)
+android_cpuInitArmCpuId(void)
 {
     char* cpuinfo = NULL;
-    int   cpuinfo_len;
+    int cpuinfo_len = load_proc_cpuinfo(&cpuinfo);
+    if (cpuinfo_len < 0)
+        return;
 
-    android_cpuInitFamily();
+    // The CPUID value is broken up in several entries in /proc/cpuinfo.
+    // This table is used to rebuild it from the entries.
+    static const struct CpuIdEntry {
+        const char* field;
+        char        format;
+        char        bit_lshift;
+        char        bit_length;
+    } cpu_id_entries[] = {
+        { "CPU implementer", 'x', 24, 8 },
+        { "CPU variant", 'x', 20, 4 },
+        { "CPU part", 'x', 4, 12 },
+        { "CPU revision", 'd', 0, 4 },
+    };
+    size_t i;
+    D("Parsing /proc/cpuinfo to recover CPUID\n");
+    for (i = 0;
+         i < sizeof(cpu_id_entries)/sizeof(cpu_id_entries[0]);
+         ++i) {
+        const struct CpuIdEntry* entry = &cpu_id_entries[i];
+        char* value = extract_cpuinfo_field(cpuinfo,
+                                            cpuinfo_len,
+                                            entry->field);
+        if (value == NULL)
+            continue;
+
+        D("field=%s value='%s'\n", entry->field, value);
+        char* value_end = value + strlen(value);
+        int val = 0;
+        const char* start = value;
+        const char* p;
+        if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
+          start += 2;
+          p = parse_hexadecimal(start, value_end, &val);
+        } else if (entry->format == 'x')
+          p = parse_hexadecimal(value, value_end, &val);
+        else
+          p = parse_decimal(value, value_end, &val);
+
+        if (p > (const char*)start) {
+          val &= ((1 << entry->bit_length)-1);
+          val <<= entry->bit_lshift;
+          g_cpuIdArm |= (uint32_t) val;
+        }
 
-    g_cpuFeatures = 0;
-    g_cpuCount    = 1;
-    g_inited      = 1;
+        free(value);
+    }
 
-    cpuinfo_len = get_file_size("/proc/cpuinfo");
-    if (cpuinfo_len < 0) {
-      D("cpuinfo_len cannot be computed!");
-      return;
+    // Remember whether this is the emulator; the fixup keyed on it
+    // needs the answer after the cpuinfo buffer is gone.
+    char* hardware = extract_cpuinfo_field(cpuinfo,
+                                           cpuinfo_len,
+                                           "Hardware");
+    if (hardware) {
+        g_cpuIsGoldfish = !strcmp(hardware, "Goldfish");
+        free(hardware);
     }
-    cpuinfo = malloc(cpuinfo_len);
-    if (cpuinfo == NULL) {
-      D("cpuinfo buffer could not be allocated");
-      return;
+
+    free(cpuinfo);
+}
+
+/* Handle kernel configuration bugs that prevent the correct reporting
+ * of CPU features. Must only be called from android_cpuInit(), under
+ * g_once: once init returns, g_cpuFeatures is published to concurrent
+ * readers, so mutating it from the lazy android_getCpuIdArm() path
+ * would be a data race and would change the reported mask over the
+ * process lifetime. The eager trigger in android_cpuInit() already
+ * covers every case where these fixups alter the mask.
+ */
+static void
+android_cpuApplyArmCpuIdFixups(void)
+{
+    static const struct CpuFix {
+        uint32_t  cpuid;
+        uint64_t  or_flags;
+    } cpu_fixes[] = {
+        /* The Nexus 4 (Qualcomm Krait) kernel configuration
+         * forgets to report IDIV support. */
+        { 0x510006f2, ANDROID_CPU_ARM_FEATURE_IDIV_ARM |
+                      ANDROID_CPU_ARM_FEATURE_IDIV_THUMB2 },
+        { 0x510006f3, ANDROID_CPU_ARM_FEATURE_IDIV_ARM |
+                      ANDROID_CPU_ARM_FEATURE_IDIV_THUMB2 },
+    };
+    size_t n;
+    for (n = 0; n < sizeof(cpu_fixes)/sizeof(cpu_fixes[0]); ++n) {
+        const struct CpuFix* entry = &cpu_fixes[n];
+
+        if (g_cpuIdArm == entry->cpuid)
+            g_cpuFeatures |= entry->or_flags;
     }
-    cpuinfo_len = read_file("/proc/cpuinfo", cpuinfo, cpuinfo_len);
-    D("cpuinfo_len is (%d):\n%.*s\n", cpuinfo_len,
-      cpuinfo_len >= 0 ? cpuinfo_len : 0, cpuinfo);
 
-    if (cpuinfo_len < 0)  /* should not happen */ {
-        free(cpuinfo);
-        return;
+    // Special case: The emulator-specific Android 4.2 kernel fails
+    // to report support for the 32-bit ARM IDIV instruction.
+    // Technically, this is a feature of the virtual CPU implemented
+    // by the emulator. Note that it could also support Thumb IDIV
+    // in the future, and this will have to be slightly updated.
+    if (g_cpuIsGoldfish &&
+        g_cpuIdArm == 0x4100c080 &&
+        (g_cpuFeatures & ANDROID_CPU_ARM_FEATURE_ARMv7) != 0) {
+        g_cpuFeatures |= ANDROID_CPU_ARM_FEATURE_IDIV_ARM;
     }
+}
+#endif /* __arm__ */
+
+static void
+android_cpuInit(void)
+{
+    android_cpuInitFamily();
+
+    g_cpuFeatures = 0;
+    g_cpuCount    = 1;
+    g_inited      = 1;
 
-    /* Count the CPU cores, the value may be 0 for single-core CPUs */
-    g_cpuCount = get_cpu_count();
-    if (g_cpuCount == 0) {
-        g_cpuCount = 1;
+    /* Counting the CPU cores no longer requires reading the sysfs cpu
+     * lists: the C library provides the same answer without any file
+     * I/O. Keep the sysfs parser as a fallback for kernels where
+     * sysconf() is not usable.
+     */
+    long cpuCountConf = sysconf(_SC_NPROCESSORS_CONF);
+    if (cpuCountConf > 0) {
+        g_cpuCount = (int)cpuCountConf;
+    } else {
+        /* Count the CPU cores, the value may be 0 for single-core CPUs */
+        g_cpuCount = get_cpu_count();
+        if (g_cpuCount == 0) {
+            g_cpuCount = 1;
+        }
     }
 
     D("found cpuCount = %d\n", g_cpuCount);
 
 #ifdef __arm__
     {
-        /* Extract architecture from the "CPU Architecture" field.
-         * The list is well-known, unlike the the output of
-         * the 'Processor' field which can vary greatly.
-         *
-         * See the definition of the 'proc_arch' array in
-         * $KERNEL/arch/arm/kernel/setup.c and the 'c_show' function in
-         * same file.
+        /* Extract the list of CPU features from ELF hwcaps. The kernel
+         * also publishes the CPU architecture revision as the AT_PLATFORM
+         * string (e.g. "v7l"), which together with the hwcaps gives the
+         * feature decoding below everything it needs with zero file I/O.
          */
-        char* cpuArch = extract_cpuinfo_field(cpuinfo, cpuinfo_len, "CPU architecture");
-
-        if (cpuArch != NULL) {
-            char*  end;
-            long   archNumber;
-            int    hasARMv7 = 0;
-
-            D("found cpuArch = '%s'\n", cpuArch);
-
-            /* read the initial decimal number, ignore the rest */
-            archNumber = strtol(cpuArch, &end, 10);
+        uint32_t hwcaps = getauxval(AT_HWCAP);
+        long architecture = 0;
 
-            /* Note that ARMv8 is upwards compatible with ARMv7. */
-            if (end > cpuArch && archNumber >= 7) {
-                hasARMv7 = 1;
-            }
+        const char* platform = (const char*)getauxval(AT_PLATFORM);
+        if (platform != NULL && platform[0] == 'v') {
+            architecture = strtol(platform + 1, NULL, 10);
+            D("found AT_PLATFORM = '%s'\n", platform);
+        }
 
-            /* Unfortunately, it seems that certain ARMv6-based CPUs
-             * report an incorrect architecture number of 7!
-             *
-             * See http://code.google.com/p/android/issues/detail?id=10812
-             *
-             * We try to correct this by looking at the 'elf_format'
-             * field reported by the 'Processor' field, which is of the
-             * form of "(v7l)" for an ARMv7-based CPU, and "(v6l)" for
-             * an ARMv6-one.
+        if (hwcaps == 0 || architecture == 0) {
+            /* Fallback for kernels or processes that cannot use the aux
+             * vector: recover both values from /proc/cpuinfo, as older
+             * releases of this library always did.
              */
-            if (hasARMv7) {
-                char* cpuProc = extract_cpuinfo_field(cpuinfo, cpuinfo_len,
-                                                      "Processor");
-                if (cpuProc != NULL) {
-                    D("found cpuProc = '%s'\n", cpuProc);
-                    if (has_list_item(cpuProc, "(v6l)")) {
-                        D("CPU processor and architecture mismatch!!\n");
-                        hasARMv7 = 0;
+            char* cpuinfo = NULL;
+            int cpuinfo_len = load_proc_cpuinfo(&cpuinfo);
+            if (cpuinfo_len >= 0) {
+                if (architecture == 0) {
+                    /* Extract architecture from the "CPU Architecture"
+                     * field. The list is well-known, unlike the the output
+                     * of the 'Processor' field which can vary greatly.
+                     *
+                     * See the definition of the 'proc_arch' array in
+                     * $KERNEL/arch/arm/kernel/setup.c and the 'c_show'
+                     * function in same file.
+                     */
+                    char* cpuArch = extract_cpuinfo_field(cpuinfo,
+                                                          cpuinfo_len,
+                                                          "CPU architecture");
+                    if (cpuArch != NULL) {
+                        D("found cpuArch = '%s'\n", cpuArch);
+
+                        /* read the initial decimal number, ignore the rest */
+                        architecture = strtol(cpuArch, NULL, 10);
+                        free(cpuArch);
                     }
-                    free(cpuProc);
                 }
-            }
 
-            if (hasARMv7) {
-                g_cpuFeatures |= ANDROID_CPU_ARM_FEATURE_ARMv7;
-            }
+                /* Unfortunately, it seems that certain ARMv6-based CPUs
+                 * report an incorrect architecture number of 7!
+                 *
+                 * See http://code.google.com/p/android/issues/detail?id=10812
+                 *
+                 * We try to correct this by looking at the 'elf_format'
+                 * field reported by the 'Processor' field, which is of the
+                 * form of "(v7l)" for an ARMv7-based CPU, and "(v6l)" for
+                 * an ARMv6-one.
+                 */
+                if (architecture >= 7) {
+                    char* cpuProc = extract_cpuinfo_field(cpuinfo, cpuinfo_len,
+                                                          "Processor");
+                    if (cpuProc != NULL) {
+                        D("found cpuProc = '%s'\n", cpuProc);
+                        if (has_list_item(cpuProc, "(v6l)")) {
+                            D("CPU processor and architecture mismatch!!\n");
+                            architecture = 6;
+                        }
+                        free(cpuProc);
+                    }
+                }
 
-            /* The LDREX / STREX instructions are available from ARMv6 */
-            if (archNumber >= 6) {
-                g_cpuFeatures |= ANDROID_CPU_ARM_FEATURE_LDREX_STREX;
-            }
+                if (hwcaps == 0) {
+                    D("Parsing /proc/self/auxv to extract ELF hwcaps!\n");
+                    hwcaps = get_elf_hwcap_from_proc_self_auxv();
+                }
+                if (hwcaps == 0) {
+                    // Parsing /proc/self/auxv will fail from regular
+                    // application processes on some Android platform
+                    // versions, when this happens parse proc/cpuinfo
+                    // instead.
+                    D("Parsing /proc/cpuinfo to extract ELF hwcaps!\n");
+                    hwcaps = get_elf_hwcap_from_proc_cpuinfo(cpuinfo,
+                                                             cpuinfo_len);
+                }
 
-            free(cpuArch);
+                free(cpuinfo);
+            }
         }
 
-        /* Extract the list of CPU features from ELF hwcaps */
-        uint32_t hwcaps = getauxval(AT_HWCAP);
-        if (!hwcaps) {
-            D("Parsing /proc/self/auxv to extract ELF hwcaps!\n");
-            hwcaps = get_elf_hwcap_from_proc_self_auxv();
+        /* Note that ARMv8 is upwards compatible with ARMv7. */
+        if (architecture >= 7) {
+            g_cpuFeatures |= ANDROID_CPU_ARM_FEATURE_ARMv7;
         }
-        if (!hwcaps) {
-            // Parsing /proc/self/auxv will fail from regular application
-            // processes on some Android platform versions, when this happens
-            // parse proc/cpuinfo instead.
-            D("Parsing /proc/cpuinfo to extract ELF hwcaps!\n");
-            hwcaps = get_elf_hwcap_from_proc_cpuinfo(cpuinfo, cpuinfo_len);
+
+        /* The LDREX / STREX instructions are available from ARMv6 */
+        if (architecture >= 6) {
+            g_cpuFeatures |= ANDROID_CPU_ARM_FEATURE_LDREX_STREX;
         }
 
         if (hwcaps != 0) {
@@ -813,90 +1107,17 @@ android_cpuInit(void)
             if (has_crc32)
                 g_cpuFeatures |= ANDROID_CPU_ARM_FEATURE_CRC32;
         }
-        /* Extract the cpuid value from various fields */
-        // The CPUID value is broken up in several entries in /proc/cpuinfo.
-        // This table is used to rebuild it from the entries.
-        static const struct CpuIdEntry {
-            const char* field;
-            char        format;
-            char        bit_lshift;
-            char        bit_length;
-        } cpu_id_entries[] = {
-            { "CPU implementer", 'x', 24, 8 },
-            { "CPU variant", 'x', 20, 4 },
-            { "CPU part", 'x', 4, 12 },
-            { "CPU revision", 'd', 0, 4 },
-        };
-        size_t i;
-        D("Parsing /proc/cpuinfo to recover CPUID\n");
-        for (i = 0;
-             i < sizeof(cpu_id_entries)/sizeof(cpu_id_entries[0]);
-             ++i) {
-            const struct CpuIdEntry* entry = &cpu_id_entries[i];
-            char* value = extract_cpuinfo_field(cpuinfo,
-                                                cpuinfo_len,
-                                                entry->field);
-            if (value == NULL)
-                continue;
-
-            D("field=%s value='%s'\n", entry->field, value);
-            char* value_end = value + strlen(value);
-            int val = 0;
-            const char* start = value;
-            const char* p;
-            if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
-              start += 2;
-              p = parse_hexadecimal(start, value_end, &val);
-            } else if (entry->format == 'x')
-              p = parse_hexadecimal(value, value_end, &val);
-            else
-              p = parse_decimal(value, value_end, &val);
-
-            if (p > (const char*)start) {
-              val &= ((1 << entry->bit_length)-1);
-              val <<= entry->bit_lshift;
-              g_cpuIdArm |= (uint32_t) val;
-            }
-
-            free(value);
-        }
-
-        // Handle kernel configuration bugs that prevent the correct
-        // reporting of CPU features.
-        static const struct CpuFix {
-            uint32_t  cpuid;
-            uint64_t  or_flags;
-        } cpu_fixes[] = {
-            /* The Nexus 4 (Qualcomm Krait) kernel configuration
-             * forgets to report IDIV support. */
-            { 0x510006f2, ANDROID_CPU_ARM_FEATURE_IDIV_ARM |
-                          ANDROID_CPU_ARM_FEATURE_IDIV_THUMB2 },
-            { 0x510006f3, ANDROID_CPU_ARM_FEATURE_IDIV_ARM |
-                          ANDROID_CPU_ARM_FEATURE_IDIV_THUMB2 },
-        };
-        size_t n;
-        for (n = 0; n < sizeof(cpu_fixes)/sizeof(cpu_fixes[0]); ++n) {
-            const struct CpuFix* entry = &cpu_fixes[n];
-
-            if (g_cpuIdArm == entry->cpuid)
-                g_cpuFeatures |= entry->or_flags;
-        }
-
-        // Special case: The emulator-specific Android 4.2 kernel fails
-        // to report support for the 32-bit ARM IDIV instruction.
-        // Technically, this is a feature of the virtual CPU implemented
-        // by the emulator. Note that it could also support Thumb IDIV
-        // in the future, and this will have to be slightly updated.
-        char* hardware = extract_cpuinfo_field(cpuinfo,
-                                               cpuinfo_len,
-                                               "Hardware");
-        if (hardware) {
-            if (!strcmp(hardware, "Goldfish") &&
-                g_cpuIdArm == 0x4100c080 &&
-                (g_cpuFamily & ANDROID_CPU_ARM_FEATURE_ARMv7) != 0) {
-                g_cpuFeatures |= ANDROID_CPU_ARM_FEATURE_IDIV_ARM;
-            }
-            free(hardware);
+        /* The feature fixups are keyed on the ARM CPUID, which is only
+         * available from /proc/cpuinfo. Only pay for that parse when
+         * the decoded features look suspicious (the fixups can only add
+         * IDIV bits, so a mask that already has them needs none);
+         * android_getCpuIdArm() still recovers the CPUID lazily, but
+         * never touches the published feature mask.
+         */
+        if ((g_cpuFeatures & ANDROID_CPU_ARM_FEATURE_ARMv7) != 0 &&
+            (g_cpuFeatures & ANDROID_CPU_ARM_FEATURE_IDIV_ARM) == 0) {
+            pthread_once(&g_cpuIdOnce, android_cpuInitArmCpuId);
+            android_cpuApplyArmCpuIdFixups();
         }
     }
 #endif /* __arm__ */
@@ -934,6 +1155,32 @@ android_cpuInit(void)
                 g_cpuFeatures |= ANDROID_CPU_ARM64_FEATURE_SHA2;
             if (has_crc32)
                 g_cpuFeatures |= ANDROID_CPU_ARM64_FEATURE_CRC32;
+
+            /* ARMv8.x extensions are reported through the extended
+             * feature word; the FEAT_FP16 bit requires half-precision
+             * arithmetic in both the scalar and Advanced SIMD register
+             * files.
+             */
+            if ((hwcaps & HWCAP_FPHP) && (hwcaps & HWCAP_ASIMDHP))
+                g_cpuFeaturesEx |= ANDROID_CPU_ARM64_FEATURE_FP16;
+            if (hwcaps & HWCAP_ATOMICS)
+                g_cpuFeaturesEx |= ANDROID_CPU_ARM64_FEATURE_LSE;
+            if (hwcaps & HWCAP_ASIMDDP)
+                g_cpuFeaturesEx |= ANDROID_CPU_ARM64_FEATURE_DOTPROD;
+            if (hwcaps & HWCAP_SVE)
+                g_cpuFeaturesEx |= ANDROID_CPU_ARM64_FEATURE_SVE;
+        }
+
+        /* Extract the list of CPU features from ELF hwcaps2 */
+        uint32_t hwcaps2 = getauxval(AT_HWCAP2);
+        if (hwcaps2 != 0) {
+            if (hwcaps2 & HWCAP2_SVE2)
+                g_cpuFeaturesEx |= ANDROID_CPU_ARM64_FEATURE_SVE2 |
+                                   ANDROID_CPU_ARM64_FEATURE_SVE;
+            if (hwcaps2 & HWCAP2_I8MM)
+                g_cpuFeaturesEx |= ANDROID_CPU_ARM64_FEATURE_I8MM;
+            if (hwcaps2 & HWCAP2_BF16)
+                g_cpuFeaturesEx |= ANDROID_CPU_ARM64_FEATURE_BF16;
         }
     }
 #endif /* __aarch64__ */
@@ -987,8 +1234,6 @@ android_cpuInit(void)
 
 
 #endif
-
-    free(cpuinfo);
 }
 
 
@@ -1003,55 +1248,502 @@ android_getCpuFamily(void)
 uint64_t
 android_getCpuFeatures(void)
 {
+    /* Check the override before pthread_once so a sandboxed process
+     * whose broker called android_setCpu() first never attempts the
+     * kernel probe at all.
+     */
+    AndroidCpuOverride* over =
+        __atomic_load_n(&g_cpuOverride, __ATOMIC_ACQUIRE);
+    if (over != NULL)
+        return over->cpu_features;
+
     pthread_once(&g_once, android_cpuInit);
     return g_cpuFeatures;
 }
 
 
+uint64_t
+android_getCpuFeaturesEx(void)
+{
+    /* Same contract as android_getCpuFeatures(): an installed override
+     * must keep this accessor from probing the kernel, notably because
+     * android_cpuResolve() reads both masks. android_setCpu() cannot
+     * carry the extended bits, so the override reports an empty mask
+     * and variants needing extended features fall back.
+     */
+    AndroidCpuOverride* over =
+        __atomic_load_n(&g_cpuOverride, __ATOMIC_ACQUIRE);
+    if (over != NULL)
+        return over->cpu_features_ex;
+
+    pthread_once(&g_once, android_cpuInit);
+    return g_cpuFeaturesEx;
+}
+
+
 int
 android_getCpuCount(void)
 {
+    AndroidCpuOverride* over =
+        __atomic_load_n(&g_cpuOverride, __ATOMIC_ACQUIRE);
+    if (over != NULL)
+        return over->cpu_count;
+
     pthread_once(&g_once, android_cpuInit);
     return g_cpuCount;
 }
 
+/* Refreshing the online CPU list costs a syscall and a small parse, so
+ * cache the result and only re-read sysfs when the cached value is
+ * older than this. 100 ms is well below the rate at which schedulers
+ * react to hotplug, while keeping the hot-path cost to one coarse
+ * clock read.
+ */
+#define CPU_COUNT_ONLINE_LIFETIME_NS  (100LL * 1000000LL)
+
+static uint64_t g_cpuCountOnlineTime;
+static int      g_cpuCountOnline;
+
+int
+android_getCpuCountOnline(void)
+{
+    struct timespec ts;
+    uint64_t now = 0;
+    uint64_t last;
+    int count;
+
+    pthread_once(&g_once, android_cpuInit);
+
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+        now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+
+    /* Plain relaxed atomics are enough here: the worst outcome of a
+     * race is one redundant sysfs read.
+     */
+    last = __atomic_load_n(&g_cpuCountOnlineTime, __ATOMIC_RELAXED);
+    count = __atomic_load_n(&g_cpuCountOnline, __ATOMIC_RELAXED);
+    if (count > 0 && now != 0 && (now - last) < CPU_COUNT_ONLINE_LIFETIME_NS)
+        return count;
+
+    CpuList cpus_online[1];
+    cpulist_read_from(cpus_online, "/sys/devices/system/cpu/online");
+    count = cpulist_count(cpus_online);
+    if (count <= 0) {
+        /* Kernel without an online list; every configured core is as
+         * good an answer as any.
+         */
+        count = g_cpuCount;
+    }
+
+    __atomic_store_n(&g_cpuCountOnline, count, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_cpuCountOnlineTime, now, __ATOMIC_RELAXED);
+    return count;
+}
+
+static pthread_once_t       g_cpuCacheOnce;
+static uint32_t             g_cpuCacheValid;
+static AndroidCpuCacheInfo  g_cpuCacheInfo[32];
+
+/* Scan the cache topology that the kernel exports under
+ * /sys/devices/system/cpu/cpuN/cache. This runs at most once; the
+ * result is cached in the statics above. As with CpuList, we don't
+ * expect more than 32 cores on mobile devices.
+ *
+ * See Documentation/ABI/testing/sysfs-devices-system-cpu in the kernel
+ * tree for the file format.
+ */
+static void
+android_cpuInitCacheInfo(void)
+{
+    int cpu, index;
+    int cpu_count = g_cpuCount;
+    if (cpu_count > 32)
+        cpu_count = 32;
+
+    for (cpu = 0; cpu < cpu_count; cpu++) {
+        AndroidCpuCacheInfo* info = &g_cpuCacheInfo[cpu];
+        int found = 0;
+
+        /* Each indexN directory describes one cache reachable from this
+         * core; stop at the first hole, the kernel numbers them
+         * contiguously.
+         */
+        for (index = 0; index < 16; index++) {
+            char path[96];
+            char type[32];
+            int  level, size, typelen;
+
+            snprintf(path, sizeof path,
+                     "/sys/devices/system/cpu/cpu%d/cache/index%d/level",
+                     cpu, index);
+            level = read_sysfs_int(path);
+            if (level < 0)
+                break;
+
+            snprintf(path, sizeof path,
+                     "/sys/devices/system/cpu/cpu%d/cache/index%d/size",
+                     cpu, index);
+            size = read_sysfs_int(path);
+            if (size < 0)
+                continue;
+
+            snprintf(path, sizeof path,
+                     "/sys/devices/system/cpu/cpu%d/cache/index%d/type",
+                     cpu, index);
+            typelen = read_file(path, type, sizeof type - 1);
+            if (typelen <= 0)
+                continue;
+            type[typelen] = '\0';
+
+            if (level == 1 && type[0] == 'D') {
+                info->l1d_cache_size = size;
+                snprintf(path, sizeof path,
+                         "/sys/devices/system/cpu/cpu%d/cache/index%d/"
+                         "coherency_line_size", cpu, index);
+                int line_size = read_sysfs_int(path);
+                if (line_size > 0)
+                    info->cache_line_size = line_size;
+            } else if (level == 1 && type[0] == 'I') {
+                info->l1i_cache_size = size;
+            } else if (level == 2) {
+                info->l2_cache_size = size;
+            } else if (level == 3) {
+                info->l3_cache_size = size;
+            }
+            found = 1;
+        }
+
+        if (found) {
+            g_cpuCacheValid |= (uint32_t)(1U << cpu);
+            D("cpu%d: line=%d L1d=%d L1i=%d L2=%d L3=%d\n", cpu,
+              info->cache_line_size, info->l1d_cache_size,
+              info->l1i_cache_size, info->l2_cache_size,
+              info->l3_cache_size);
+        }
+    }
+}
+
+int
+android_getCpuCacheInfo(int cpu_index, AndroidCpuCacheInfo* info)
+{
+    pthread_once(&g_once, android_cpuInit);
+    pthread_once(&g_cpuCacheOnce, android_cpuInitCacheInfo);
+
+    if (info == NULL ||
+        (unsigned)cpu_index >= (unsigned)g_cpuCount ||
+        cpu_index >= 32 ||
+        (g_cpuCacheValid & (1U << cpu_index)) == 0) {
+        return 0;
+    }
+
+    *info = g_cpuCacheInfo[cpu_index];
+    return 1;
+}
+
+static pthread_once_t        g_cpuTopologyOnce;
+static int                   g_cpuMaxFreq[32];
+static int                   g_cpuClusterCount;
+static AndroidCpuClusterInfo g_cpuClusters[8];
+
+/* Enumerate core clusters from per-core cpufreq limits. Cores that
+ * report the same cpuinfo_max_freq value belong to the same cluster on
+ * every known big.LITTLE design, which saves us from parsing the
+ * cpu topology directories. The scan runs at most once.
+ */
+static void
+android_cpuInitTopology(void)
+{
+    int cpu, n;
+    int cpu_count = g_cpuCount;
+    if (cpu_count > 32)
+        cpu_count = 32;
+
+    /* Group cores into clusters by their maximum frequency. */
+    for (cpu = 0; cpu < cpu_count; cpu++) {
+        char path[96];
+        int  freq;
+
+        snprintf(path, sizeof path,
+                 "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq",
+                 cpu);
+        freq = read_sysfs_int(path);
+        if (freq < 0)
+            freq = 0;
+        g_cpuMaxFreq[cpu] = freq;
+
+        for (n = 0; n < g_cpuClusterCount; n++) {
+            if (g_cpuClusters[n].max_freq_khz == freq)
+                break;
+        }
+        if (n == g_cpuClusterCount) {
+            if (g_cpuClusterCount ==
+                (int)(sizeof(g_cpuClusters)/sizeof(g_cpuClusters[0])))
+                continue;
+            g_cpuClusterCount++;
+            g_cpuClusters[n].max_freq_khz = freq;
+        }
+        g_cpuClusters[n].cpu_mask |= (uint32_t)(1U << cpu);
+        g_cpuClusters[n].cpu_count++;
+    }
+
+    if (g_cpuClusterCount == 0) {
+        /* Be defensive against empty sysfs; report one UNKNOWN cluster
+         * covering every core so callers always get a valid answer.
+         */
+        g_cpuClusterCount = 1;
+        g_cpuClusters[0].cpu_count = g_cpuCount;
+        g_cpuClusters[0].cpu_mask =
+            (g_cpuCount >= 32) ? ~0U : ((1U << g_cpuCount) - 1U);
+    }
+
+    /* Sort clusters by increasing maximum frequency (insertion sort,
+     * the array is tiny).
+     */
+    for (n = 1; n < g_cpuClusterCount; n++) {
+        AndroidCpuClusterInfo key = g_cpuClusters[n];
+        int m = n - 1;
+        while (m >= 0 && g_cpuClusters[m].max_freq_khz > key.max_freq_khz) {
+            g_cpuClusters[m+1] = g_cpuClusters[m];
+            m--;
+        }
+        g_cpuClusters[m+1] = key;
+    }
+
+    /* Classify: the slowest cluster is LITTLE, the fastest is PRIME when
+     * it is a single core in a 3+ cluster design, everything else is
+     * BIG. A single homogeneous cluster is reported as BIG, or UNKNOWN
+     * when the kernel gave us no frequency data at all.
+     */
+    for (n = 0; n < g_cpuClusterCount; n++) {
+        AndroidCpuClusterInfo* cluster = &g_cpuClusters[n];
+
+        if (cluster->max_freq_khz == 0) {
+            cluster->core_type = ANDROID_CPU_CORE_TYPE_UNKNOWN;
+        } else if (g_cpuClusterCount == 1) {
+            cluster->core_type = ANDROID_CPU_CORE_TYPE_BIG;
+        } else if (n == 0) {
+            cluster->core_type = ANDROID_CPU_CORE_TYPE_LITTLE;
+        } else if (n == g_cpuClusterCount - 1 &&
+                   g_cpuClusterCount >= 3 &&
+                   cluster->cpu_count == 1) {
+            cluster->core_type = ANDROID_CPU_CORE_TYPE_PRIME;
+        } else {
+            cluster->core_type = ANDROID_CPU_CORE_TYPE_BIG;
+        }
+
+        D("cluster%d: mask=%x count=%d freq=%d type=%d\n", n,
+          cluster->cpu_mask, cluster->cpu_count, cluster->max_freq_khz,
+          cluster->core_type);
+    }
+}
+
+int
+android_getCpuClusterCount(void)
+{
+    pthread_once(&g_once, android_cpuInit);
+    pthread_once(&g_cpuTopologyOnce, android_cpuInitTopology);
+    return g_cpuClusterCount;
+}
+
+int
+android_getCpuClusterInfo(int cluster_index, AndroidCpuClusterInfo* info)
+{
+    pthread_once(&g_once, android_cpuInit);
+    pthread_once(&g_cpuTopologyOnce, android_cpuInitTopology);
+
+    if (info == NULL ||
+        (unsigned)cluster_index >= (unsigned)g_cpuClusterCount) {
+        return 0;
+    }
+
+    *info = g_cpuClusters[cluster_index];
+    return 1;
+}
+
+int
+android_getCpuMaxFreqKHz(int cpu_index)
+{
+    pthread_once(&g_once, android_cpuInit);
+    pthread_once(&g_cpuTopologyOnce, android_cpuInitTopology);
+
+    if ((unsigned)cpu_index >= (unsigned)g_cpuCount || cpu_index >= 32)
+        return 0;
+
+    return g_cpuMaxFreq[cpu_index];
+}
+
+/* Per-thread cache for android_getCurrentCpu(). The cached index is
+ * trusted for as long as the coarse monotonic clock reads the same
+ * value, i.e. for at most one kernel tick. That bounds staleness to the
+ * scheduling quantum (a migrated thread has been rescheduled, which
+ * implies at least one tick) while turning repeated queries within a
+ * tick into a single vDSO clock read.
+ */
+static __thread uint64_t t_currentCpuTime;
+static __thread int      t_currentCpu = -1;
+
+int
+android_getCurrentCpu(void)
+{
+    struct timespec ts;
+    uint64_t now = 0;
+    int cpu;
+
+    pthread_once(&g_once, android_cpuInit);
+
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+        now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+
+    if (t_currentCpu >= 0 && now != 0 && now == t_currentCpuTime)
+        return t_currentCpu;
+
+    cpu = sched_getcpu();
+    if (cpu < 0)
+        cpu = 0;
+
+    t_currentCpu = cpu;
+    t_currentCpuTime = now;
+    return cpu;
+}
+
+AndroidCpuCoreType
+android_getCpuCoreType(int cpu_index)
+{
+    int n;
+
+    pthread_once(&g_once, android_cpuInit);
+    pthread_once(&g_cpuTopologyOnce, android_cpuInitTopology);
+
+    if ((unsigned)cpu_index >= (unsigned)g_cpuCount || cpu_index >= 32)
+        return ANDROID_CPU_CORE_TYPE_UNKNOWN;
+
+    for (n = 0; n < g_cpuClusterCount; n++) {
+        if (g_cpuClusters[n].cpu_mask & (1U << cpu_index))
+            return g_cpuClusters[n].core_type;
+    }
+    return ANDROID_CPU_CORE_TYPE_UNKNOWN;
+}
+
+int
+android_getCurrentCpuCacheInfo(AndroidCpuCacheInfo* info)
+{
+    return android_getCpuCacheInfo(android_getCurrentCpu(), info);
+}
+
+void*
+android_cpuResolve(const AndroidCpuVariant* variants,
+                   int count,
+                   void* fallback,
+                   void** cache)
+{
+    void* resolved;
+    uint64_t features;
+    uint64_t features_ex;
+    int n;
+
+    if (cache != NULL) {
+        resolved = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+        if (resolved != NULL)
+            return resolved;
+    }
+
+    features    = android_getCpuFeatures();
+    features_ex = android_getCpuFeaturesEx();
+
+    resolved = fallback;
+    for (n = 0; n < count; n++) {
+        const AndroidCpuVariant* variant = &variants[n];
+        if ((features & variant->required_features) ==
+                variant->required_features &&
+            (features_ex & variant->required_features_ex) ==
+                variant->required_features_ex) {
+            resolved = variant->func;
+            break;
+        }
+    }
+
+    /* Two threads racing here resolve to the same pointer, so the
+     * publication order does not matter.
+     */
+    if (cache != NULL && resolved != NULL)
+        __atomic_store_n(cache, resolved, __ATOMIC_RELEASE);
+
+    return resolved;
+}
+
 static void
 android_cpuInitTrivial(void)
 {
     g_inited = 1;
 }
 
-int
-android_setCpu(int cpu_count, uint64_t cpu_features)
+/* Build and publish a new override. Readers pick it up through one
+ * acquire load, so an update can race with any android_getCpuXXX call
+ * and can arrive at any point in the process lifetime, including after
+ * first init.
+ */
+static int
+android_setCpuOverride(int      cpu_count,
+                       uint64_t cpu_features,
+                       uint32_t cpu_id,
+                       int      has_cpu_id)
 {
-    /* Fail if the library was already initialized. */
-    if (g_inited)
+    AndroidCpuOverride* over = malloc(sizeof(*over));
+    if (over == NULL)
         return 0;
 
+    over->cpu_count       = (cpu_count <= 0 ? 1 : cpu_count);
+    over->cpu_features    = cpu_features;
+    /* The public setters predate the extended mask and cannot carry
+     * it; the override deliberately reports it as empty.
+     */
+    over->cpu_features_ex = 0;
+    over->cpu_id          = cpu_id;
+    over->has_cpu_id      = has_cpu_id;
+
+    /* If no android_getCpuXXX call ran yet, claim the one-time init so
+     * a later call never probes the kernel; the family is always known
+     * at compile time. android_cpuInitFamily() writes the same constant
+     * every time, so re-running it after a real init is harmless.
+     */
     android_cpuInitFamily();
-    g_cpuCount = (cpu_count <= 0 ? 1 : cpu_count);
-    g_cpuFeatures = cpu_features;
     pthread_once(&g_once, android_cpuInitTrivial);
 
+    /* Publish. A previous override is intentionally leaked: a reader
+     * may still hold a pointer to it, and overrides are installed at
+     * most a handful of times per process.
+     */
+    __atomic_store_n(&g_cpuOverride, over, __ATOMIC_RELEASE);
     return 1;
 }
 
+int
+android_setCpu(int cpu_count, uint64_t cpu_features)
+{
+    return android_setCpuOverride(cpu_count, cpu_features, 0, 0);
+}
+
 #ifdef __arm__
 uint32_t
 android_getCpuIdArm(void)
 {
+    AndroidCpuOverride* over =
+        __atomic_load_n(&g_cpuOverride, __ATOMIC_ACQUIRE);
+    if (over != NULL && over->has_cpu_id)
+        return over->cpu_id;
+
     pthread_once(&g_once, android_cpuInit);
+    /* The CPUID is recovered lazily, since the fast init path never
+     * needs to parse /proc/cpuinfo.
+     */
+    pthread_once(&g_cpuIdOnce, android_cpuInitArmCpuId);
     return g_cpuIdArm;
 }
 
 int
 android_setCpuArm(int cpu_count, uint64_t cpu_features, uint32_t cpu_id)
 {
-    if (!android_setCpu(cpu_count, cpu_features))
-        return 0;
-
-    g_cpuIdArm = cpu_id;
-    return 1;
+    return android_setCpuOverride(cpu_count, cpu_features, cpu_id, 1);
 }
 #endif  /* __arm__ */
 
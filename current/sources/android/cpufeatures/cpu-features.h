@@ -253,6 +253,62 @@ enum {
     ANDROID_CPU_ARM64_FEATURE_CRC32   = (1 << 6),
 };
 
+/* The bit flags corresponding to the output of android_getCpuFeaturesEx()
+ * when android_getCpuFamily() returns ANDROID_CPU_FAMILY_ARM64. These
+ * describe the optional ARMv8.x SIMD and atomics extensions. Value
+ * details are:
+ *
+ *   FP16:
+ *     CPU supports half-precision (16-bit) floating-point arithmetic,
+ *     in both the scalar FP and Advanced SIMD register files
+ *     (FEAT_FP16).
+ *
+ *   LSE:
+ *     CPU supports the Large System Extensions, i.e. single-instruction
+ *     atomics such as LDADD and CAS (FEAT_LSE).
+ *
+ *   DOTPROD:
+ *     CPU supports the SDOT and UDOT dot-product instructions
+ *     (FEAT_DotProd).
+ *
+ *   SVE:
+ *     CPU supports the Scalable Vector Extension (FEAT_SVE).
+ *
+ *   SVE2:
+ *     CPU supports the Scalable Vector Extension version 2 (FEAT_SVE2).
+ *     This implies SVE.
+ *
+ *   I8MM:
+ *     CPU supports the Int8 matrix multiplication instructions, e.g.
+ *     SMMLA and USDOT (FEAT_I8MM).
+ *
+ *   BF16:
+ *     CPU supports the BFloat16 instructions, e.g. BFDOT and BFMMLA
+ *     (FEAT_BF16).
+ */
+enum {
+    ANDROID_CPU_ARM64_FEATURE_FP16    = (1 << 0),
+    ANDROID_CPU_ARM64_FEATURE_LSE     = (1 << 1),
+    ANDROID_CPU_ARM64_FEATURE_DOTPROD = (1 << 2),
+    ANDROID_CPU_ARM64_FEATURE_SVE     = (1 << 3),
+    ANDROID_CPU_ARM64_FEATURE_SVE2    = (1 << 4),
+    ANDROID_CPU_ARM64_FEATURE_I8MM    = (1 << 5),
+    ANDROID_CPU_ARM64_FEATURE_BF16    = (1 << 6),
+};
+
+/* Return a second bitmap of optional CPU features, describing the
+ * ARMv8.x extensions listed above. The result is only meaningful when
+ * android_getCpuFamily() returns ANDROID_CPU_FAMILY_ARM64; it is 0 for
+ * all other families. Detection shares the initialization path of
+ * android_getCpuFeatures(), so calling either function makes both
+ * effectively free afterwards.
+ *
+ * When an android_setCpu() override is installed, this returns 0:
+ * the setters cannot carry the extended mask, so feature-gated code
+ * conservatively falls back to its baseline implementations.
+ */
+extern uint64_t android_getCpuFeaturesEx(void);
+
 /* The bit flags corresponding to the output of android_getCpuFeatures()
  * when android_getCpuFamily() returns ANDROID_CPU_FAMILY_X86 or
  * ANDROID_CPU_FAMILY_X86_64.
@@ -290,15 +346,172 @@ enum {
 /* Return the number of CPU cores detected on this device. */
 extern int android_getCpuCount(void);
 
+/* Return the number of CPU cores that are currently online. Android
+ * kernels hotplug cores constantly, so unlike android_getCpuCount()
+ * this value can change over the life of the process.
+ *
+ * The result is cached and refreshed from sysfs at most every 100 ms,
+ * so it is safe to call this on a hot path (the common case is a single
+ * coarse clock read). Falls back to android_getCpuCount() on kernels
+ * without an online CPU list.
+ */
+extern int android_getCpuCountOnline(void);
+
+/* Describes the cache hierarchy visible to one CPU core, as reported by
+ * the kernel under /sys/devices/system/cpu/cpuN/cache. All sizes are in
+ * bytes. A value of 0 means the kernel did not report the corresponding
+ * cache; this is common for L3 on devices without a system-level cache.
+ *
+ * On big.LITTLE devices, cores in different clusters typically report
+ * different L1/L2 sizes, so query the core you intend to run on rather
+ * than assuming core 0 is representative.
+ */
+typedef struct {
+    int cache_line_size;  /* Coherency line size of the L1 data cache. */
+    int l1d_cache_size;
+    int l1i_cache_size;
+    int l2_cache_size;
+    int l3_cache_size;
+} AndroidCpuCacheInfo;
+
+/* Retrieve the cache hierarchy description for the CPU core with the
+ * given index (0 .. android_getCpuCount()-1) into '*info'.
+ *
+ * The sysfs scan is performed once and cached, so repeated calls are
+ * cheap. Returns 1 on success, and 0 on failure (bad index, or kernel
+ * without cache topology support).
+ */
+extern int android_getCpuCacheInfo(int cpu_index, AndroidCpuCacheInfo* info);
+
+/* Classification of a CPU core within an asymmetric (big.LITTLE)
+ * design. On homogeneous devices all cores are reported as BIG. UNKNOWN
+ * is returned when the kernel does not expose cpufreq information.
+ */
+typedef enum {
+    ANDROID_CPU_CORE_TYPE_UNKNOWN = 0,
+    ANDROID_CPU_CORE_TYPE_LITTLE,
+    ANDROID_CPU_CORE_TYPE_BIG,
+    ANDROID_CPU_CORE_TYPE_PRIME,
+} AndroidCpuCoreType;
+
+/* Describes one cluster of identical CPU cores. Cores are grouped into
+ * a cluster when they report the same maximum cpufreq frequency, which
+ * matches the physical cluster layout on every known big.LITTLE device.
+ *
+ * The 'cpu_mask' field can be fed directly into sched_setaffinity() to
+ * pin latency-critical threads onto a specific cluster.
+ */
+typedef struct {
+    uint32_t           cpu_mask;      /* Bit N set if core N is in this cluster. */
+    int                cpu_count;     /* Number of cores in this cluster. */
+    int                max_freq_khz;  /* cpuinfo_max_freq, 0 if unknown. */
+    AndroidCpuCoreType core_type;
+} AndroidCpuClusterInfo;
+
+/* Return the number of CPU core clusters on this device. Always at
+ * least 1. Homogeneous devices report a single cluster covering every
+ * core.
+ */
+extern int android_getCpuClusterCount(void);
+
+/* Retrieve the description of one cluster into '*info'. Clusters are
+ * ordered by increasing maximum frequency, so index 0 is the LITTLE
+ * cluster on asymmetric devices. The underlying sysfs scan is performed
+ * once and cached. Returns 1 on success, 0 on failure (bad index).
+ */
+extern int android_getCpuClusterInfo(int cluster_index,
+                                     AndroidCpuClusterInfo* info);
+
+/* Return the maximum cpufreq frequency of the given core in kHz, or 0
+ * if the kernel does not report it. Cheap after the first call.
+ */
+extern int android_getCpuMaxFreqKHz(int cpu_index);
+
+/* Return the index of the core the calling thread is currently running
+ * on (0 .. android_getCpuCount()-1).
+ *
+ * The scheduler can migrate the thread at any moment, so the result is
+ * inherently a hint: it may be stale by the time the caller acts on it.
+ * That is good enough to pick cache-blocking parameters for the next
+ * tile of work, which is what this is for on big.LITTLE devices.
+ *
+ * The value is cached per thread and revalidated at most once per
+ * kernel tick (via the coarse monotonic clock), so the common case is a
+ * vDSO clock read rather than a getcpu() call, and it is safe to query
+ * from inner loops. Returns 0 on kernels without getcpu() support.
+ */
+extern int android_getCurrentCpu(void);
+
+/* Return the big.LITTLE classification of the given core, or UNKNOWN
+ * on a bad index or when the kernel exposes no cpufreq information.
+ * Cheap after the first call.
+ */
+extern AndroidCpuCoreType android_getCpuCoreType(int cpu_index);
+
+/* Convenience wrapper: retrieve the cache hierarchy of the core the
+ * calling thread is currently running on. Equivalent to passing
+ * android_getCurrentCpu() to android_getCpuCacheInfo(), with the same
+ * staleness caveat as android_getCurrentCpu(). Returns 1 on success,
+ * 0 on failure.
+ */
+extern int android_getCurrentCpuCacheInfo(AndroidCpuCacheInfo* info);
+
+/* One candidate implementation for android_cpuResolve(). A variant is
+ * eligible when every bit in 'required_features' is present in
+ * android_getCpuFeatures(), and every bit in 'required_features_ex' is
+ * present in android_getCpuFeaturesEx(). Either mask may be 0.
+ */
+typedef struct {
+    uint64_t required_features;
+    uint64_t required_features_ex;
+    void*    func;
+} AndroidCpuVariant;
+
+/* Select one implementation out of a list of feature-gated variants.
+ *
+ * Scans 'variants' in order and returns the 'func' of the first entry
+ * whose feature requirements are satisfied by the current device, or
+ * 'fallback' when none match. Order the variants from most to least
+ * specialized.
+ *
+ * When 'cache' is non-NULL, the resolved pointer is published into
+ * '*cache' and subsequent calls return it directly, so per-call cost
+ * collapses to one atomic load. This makes the common usage pattern a
+ * one-liner:
+ *
+ *   static void* resolved;
+ *   void my_kernel(void) {
+ *       ((void (*)(void))android_cpuResolve(
+ *           kVariants, kVariantCount, &my_kernel_generic, &resolved))();
+ *   }
+ *
+ * The cache may be shared between threads without extra locking.
+ */
+extern void* android_cpuResolve(const AndroidCpuVariant* variants,
+                                int count,
+                                void* fallback,
+                                void** cache);
+
 /* The following is used to force the CPU count and features
  * mask in sandboxed processes. Under 4.1 and higher, these processes
  * cannot access /proc, which is the only way to get information from
  * the kernel about the current hardware (at least on ARM).
  *
- * It _must_ be called only once, and before any android_getCpuXXX
- * function, any other case will fail.
- *
- * This function return 1 on success, and 0 on failure.
+ * The override is published atomically: it may be installed at any
+ * time, from any thread, before or after the first android_getCpuXXX
+ * call, and may be installed more than once. Concurrent readers always
+ * observe either the previous state or the complete new one, never a
+ * mix. This lets a sandboxed process start with conservative defaults
+ * and upgrade once the real feature mask arrives over IPC.
+ *
+ * Calling it before any android_getCpuXXX function additionally
+ * guarantees the library never attempts to probe the kernel. While an
+ * override is installed, android_getCpuFeaturesEx() reports an empty
+ * mask (see there). Note the guarantee does not extend to the topology
+ * accessors (android_getCpuCountOnline(), the cluster and cache
+ * queries), which have no meaning without the real kernel topology.
+ *
+ * This function returns 1 on success, and 0 on failure.
  */
 extern int android_setCpu(int      cpu_count,
                           uint64_t cpu_features);
@@ -311,7 +524,8 @@ extern int android_setCpu(int      cpu_count,
 extern uint32_t android_getCpuIdArm(void);
 
 /* An ARM-specific variant of android_setCpu() that also allows you
- * to set the ARM CPUID field.
+ * to set the ARM CPUID field. Same publication semantics as
+ * android_setCpu().
  */
 extern int android_setCpuArm(int      cpu_count,
                              uint64_t cpu_features,
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "cpu-features.h"
+
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+// Cold first-call initialization cost. The library initializes once per
+// process, so each iteration runs the first android_getCpuFeatures()
+// call in a forked child. The numbers include fork/wait overhead, which
+// is stable enough to track regressions in the init path itself.
+static void BM_ColdInit(benchmark::State& state) {
+    for (auto _ : state) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            benchmark::DoNotOptimize(android_getCpuFeatures());
+            _exit(0);
+        }
+        int status;
+        waitpid(pid, &status, 0);
+    }
+}
+BENCHMARK(BM_ColdInit);
+
+// Steady-state query cost: everything below should be a pthread_once
+// fast path plus a load.
+static void BM_GetCpuFamily(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_getCpuFamily());
+    }
+}
+BENCHMARK(BM_GetCpuFamily);
+
+static void BM_GetCpuFeatures(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_getCpuFeatures());
+    }
+}
+BENCHMARK(BM_GetCpuFeatures);
+
+static void BM_GetCpuFeaturesEx(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_getCpuFeaturesEx());
+    }
+}
+BENCHMARK(BM_GetCpuFeaturesEx);
+
+static void BM_GetCpuCount(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_getCpuCount());
+    }
+}
+BENCHMARK(BM_GetCpuCount);
+
+// Hot-path cost of the hotplug-aware online count (normally a coarse
+// clock read; the 100 ms refresh amortizes to nothing here).
+static void BM_GetCpuCountOnline(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_getCpuCountOnline());
+    }
+}
+BENCHMARK(BM_GetCpuCountOnline);
+
+static void BM_GetCpuCacheInfo(benchmark::State& state) {
+    AndroidCpuCacheInfo info;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_getCpuCacheInfo(0, &info));
+    }
+}
+BENCHMARK(BM_GetCpuCacheInfo);
+
+static void BM_GetCpuClusterInfo(benchmark::State& state) {
+    AndroidCpuClusterInfo info;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_getCpuClusterInfo(0, &info));
+    }
+}
+BENCHMARK(BM_GetCpuClusterInfo);
+
+static void kernel_generic() {}
+static void kernel_simd() {}
+
+static const AndroidCpuVariant kVariants[] = {
+#if defined(__aarch64__)
+    { 0, ANDROID_CPU_ARM64_FEATURE_DOTPROD, (void*)&kernel_simd },
+    { ANDROID_CPU_ARM64_FEATURE_ASIMD, 0, (void*)&kernel_simd },
+#elif defined(__arm__)
+    { ANDROID_CPU_ARM_FEATURE_NEON, 0, (void*)&kernel_simd },
+#else
+    { ANDROID_CPU_X86_FEATURE_SSE4_2, 0, (void*)&kernel_simd },
+#endif
+};
+
+// Per-call cost of a cached resolver lookup (one acquire load).
+static void BM_CpuResolveCached(benchmark::State& state) {
+    static void* cache = nullptr;
+    const int count = sizeof(kVariants) / sizeof(kVariants[0]);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(android_cpuResolve(
+            kVariants, count, (void*)&kernel_generic, &cache));
+    }
+}
+BENCHMARK(BM_CpuResolveCached);
+
+BENCHMARK_MAIN();
@@ -18,9 +18,12 @@
 
 #include <jni.h>
 
+#include <dlfcn.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
 #include <unistd.h>
 
 #include <android/log.h>
@@ -35,26 +38,182 @@
 #  define LOGV(...)  ((void)0)
 #endif
 
+/* Instrumentation of the glue's hot paths: ATrace sections around
+ * command/input dispatch plus the counters in android_app::stats.
+ * Everything compiles to nothing unless the glue is built with
+ * -DNDK_GLUE_ENABLE_TRACING, so the default build stays lean.
+ */
+#ifdef NDK_GLUE_ENABLE_TRACING
+
+#include <time.h>
+
+/* ATrace appeared in API 23; the glue builds against the minimum API
+ * level, so the symbols are resolved at runtime like the choreographer
+ * entry points below.
+ */
+static void (*atrace_begin_section)(const char* sectionName);
+static void (*atrace_end_section)(void);
+static pthread_once_t atrace_once = PTHREAD_ONCE_INIT;
+
+static void resolve_atrace(void) {
+    atrace_begin_section = (void (*)(const char*))
+            dlsym(RTLD_DEFAULT, "ATrace_beginSection");
+    atrace_end_section = (void (*)(void))
+            dlsym(RTLD_DEFAULT, "ATrace_endSection");
+}
+
+static void glue_trace_begin(const char* name) {
+    pthread_once(&atrace_once, resolve_atrace);
+    if (atrace_begin_section != NULL) atrace_begin_section(name);
+}
+
+static void glue_trace_end(void) {
+    if (atrace_end_section != NULL) atrace_end_section();
+}
+
+static int64_t glue_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000ll + ts.tv_nsec;
+}
+
+#define GLUE_TRACE_BEGIN(name) glue_trace_begin(name)
+#define GLUE_TRACE_END()       glue_trace_end()
+
+#else
+
+#define GLUE_TRACE_BEGIN(name) ((void)0)
+#define GLUE_TRACE_END()       ((void)0)
+
+#endif  /* NDK_GLUE_ENABLE_TRACING */
+
 static void free_saved_state(struct android_app* android_app) {
     pthread_mutex_lock(&android_app->mutex);
     if (android_app->savedState != NULL) {
-        free(android_app->savedState);
+        // The restore-time copy lives inside the android_app allocation
+        // and is reclaimed with it; only app-malloc'd state is freed.
+        if (!android_app->savedStateIsInline) {
+            free(android_app->savedState);
+        }
+        android_app->savedStateIsInline = 0;
+        android_app->savedState = NULL;
+        android_app->savedStateSize = 0;
+    }
+    pthread_mutex_unlock(&android_app->mutex);
+}
+
+void* android_app_take_saved_state(struct android_app* android_app, size_t* outSize) {
+    void* savedState = NULL;
+    size_t savedStateSize = 0;
+    pthread_mutex_lock(&android_app->mutex);
+    if (android_app->savedState != NULL) {
+        savedStateSize = android_app->savedStateSize;
+        if (android_app->savedStateIsInline) {
+            // Inline state cannot outlive the android_app allocation,
+            // so taking ownership means copying it out.  This runs on
+            // the app thread, keeping the activity-thread launch path
+            // at a single allocation.
+            savedState = malloc(savedStateSize);
+            memcpy(savedState, android_app->savedState, savedStateSize);
+        } else {
+            savedState = android_app->savedState;
+        }
+        android_app->savedStateIsInline = 0;
         android_app->savedState = NULL;
         android_app->savedStateSize = 0;
     }
     pthread_mutex_unlock(&android_app->mutex);
+    if (outSize != NULL) *outSize = savedStateSize;
+    return savedState;
+}
+
+// Commands that are safe to collapse while queued: they carry no
+// per-instance payload (or their payload lives in latest-state fields
+// like pendingContentRect), so only the last of a burst matters.
+static int cmd_is_coalescible(int8_t cmd) {
+    switch (cmd) {
+        case APP_CMD_WINDOW_RESIZED:
+        case APP_CMD_WINDOW_REDRAW_NEEDED:
+        case APP_CMD_CONTENT_RECT_CHANGED:
+        case APP_CMD_CONFIG_CHANGED:
+        case APP_CMD_LOW_MEMORY:
+            return 1;
+        default:
+            return 0;
+    }
 }
 
 int8_t android_app_read_cmd(struct android_app* android_app) {
-    int8_t cmd;
-    if (read(android_app->msgread, &cmd, sizeof(cmd)) != sizeof(cmd)) {
-        LOGE("No data on command pipe!");
-        return -1;
+    uint32_t head = __atomic_load_n(&android_app->cmdRingHead, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&android_app->cmdRingTail, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        // Ring empty: consume the looper wakeup, rearm the signal, and
+        // recheck for commands published since the drain started.
+        uint64_t counter;
+        if (read(android_app->cmdEventFd, &counter, sizeof(counter)) < 0 &&
+                errno != EAGAIN) {
+            LOGE("Failure reading command eventfd: %s", strerror(errno));
+        }
+        __atomic_store_n(&android_app->cmdRingSignaled, 0, __ATOMIC_SEQ_CST);
+        tail = __atomic_load_n(&android_app->cmdRingTail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            return -1;
+        }
+    }
+
+    int8_t cmd = (int8_t)android_app->cmdRing[head % NATIVE_APP_GLUE_CMD_RING_SIZE];
+#ifdef NDK_GLUE_ENABLE_TRACING
+    {
+        uint64_t latency = (uint64_t)(glue_now_ns() -
+                android_app->cmdRingWriteTimeNs[head % NATIVE_APP_GLUE_CMD_RING_SIZE]);
+        android_app->stats.cmdsProcessed++;
+        android_app->stats.cmdLatencyTotalNs += latency;
+        if (latency > android_app->stats.cmdLatencyMaxNs) {
+            android_app->stats.cmdLatencyMaxNs = latency;
+        }
+    }
+#endif
+    __atomic_store_n(&android_app->cmdRingHead, head + 1, __ATOMIC_RELEASE);
+    if (cmd_is_coalescible(cmd)) {
+        // Unmark before the command is handled: a state update arriving
+        // from here on must enqueue a fresh command.  The SEQ_CST pair
+        // with the producer's fetch_or guarantees that an update it
+        // dropped instead is visible to this command's handler.
+        __atomic_fetch_and(&android_app->cmdPendingMask, ~(1u << cmd),
+                __ATOMIC_SEQ_CST);
     }
     if (cmd == APP_CMD_SAVE_STATE) free_saved_state(android_app);
     return cmd;
 }
 
+// Seqlock write-side brackets for the lifecycle fields (window,
+// inputQueue, contentRect, activityState).  Callers must hold
+// android_app->mutex, which serializes writers; the acquire/release
+// increments keep the bracketed field writes inside the odd window.
+static void state_write_begin(struct android_app* android_app) {
+    __atomic_fetch_add(&android_app->stateSeq, 1, __ATOMIC_ACQ_REL);
+}
+
+static void state_write_end(struct android_app* android_app) {
+    __atomic_fetch_add(&android_app->stateSeq, 1, __ATOMIC_ACQ_REL);
+}
+
+void android_app_get_state_snapshot(struct android_app* android_app,
+        struct android_app_state_snapshot* snapshot) {
+    uint32_t seqBefore, seqAfter;
+    do {
+        seqBefore = __atomic_load_n(&android_app->stateSeq, __ATOMIC_ACQUIRE);
+        snapshot->window = android_app->window;
+        snapshot->inputQueue = android_app->inputQueue;
+        snapshot->contentRect = android_app->contentRect;
+        snapshot->activityState = android_app->activityState;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seqAfter = __atomic_load_n(&android_app->stateSeq, __ATOMIC_RELAXED);
+        // Retry when a write was in flight (odd) or completed meanwhile.
+    } while ((seqBefore & 1) || seqBefore != seqAfter);
+}
+
 static void print_cur_config(struct android_app* android_app) {
     char lang[2], country[2];
     AConfiguration_getLanguage(android_app->config, lang);
@@ -88,7 +247,9 @@ void android_app_pre_exec_cmd(struct android_app* android_app, int8_t cmd) {
             if (android_app->inputQueue != NULL) {
                 AInputQueue_detachLooper(android_app->inputQueue);
             }
+            state_write_begin(android_app);
             android_app->inputQueue = android_app->pendingInputQueue;
+            state_write_end(android_app);
             if (android_app->inputQueue != NULL) {
                 LOGV("Attaching input queue to looper");
                 AInputQueue_attachLooper(android_app->inputQueue,
@@ -102,7 +263,9 @@ void android_app_pre_exec_cmd(struct android_app* android_app, int8_t cmd) {
         case APP_CMD_INIT_WINDOW:
             LOGV("APP_CMD_INIT_WINDOW");
             pthread_mutex_lock(&android_app->mutex);
+            state_write_begin(android_app);
             android_app->window = android_app->pendingWindow;
+            state_write_end(android_app);
             pthread_cond_broadcast(&android_app->cond);
             pthread_mutex_unlock(&android_app->mutex);
             break;
@@ -118,15 +281,23 @@ void android_app_pre_exec_cmd(struct android_app* android_app, int8_t cmd) {
         case APP_CMD_STOP:
             LOGV("activityState=%d", cmd);
             pthread_mutex_lock(&android_app->mutex);
+            state_write_begin(android_app);
             android_app->activityState = cmd;
+            state_write_end(android_app);
             pthread_cond_broadcast(&android_app->cond);
             pthread_mutex_unlock(&android_app->mutex);
             break;
 
         case APP_CMD_CONFIG_CHANGED:
             LOGV("APP_CMD_CONFIG_CHANGED");
+            // Diff against the outgoing configuration so the handler
+            // can test configDiff instead of requerying every field.
+            AConfiguration_copy(android_app->prevConfig, android_app->config);
             AConfiguration_fromAssetManager(android_app->config,
                     android_app->activity->assetManager);
+            android_app->configDiff = AConfiguration_diff(
+                    android_app->prevConfig, android_app->config);
+            LOGV("Config diff: 0x%08x", android_app->configDiff);
             print_cur_config(android_app);
             break;
 
@@ -142,7 +313,9 @@ void android_app_post_exec_cmd(struct android_app* android_app, int8_t cmd) {
         case APP_CMD_TERM_WINDOW:
             LOGV("APP_CMD_TERM_WINDOW");
             pthread_mutex_lock(&android_app->mutex);
+            state_write_begin(android_app);
             android_app->window = NULL;
+            state_write_end(android_app);
             pthread_cond_broadcast(&android_app->cond);
             pthread_mutex_unlock(&android_app->mutex);
             break;
@@ -171,6 +344,7 @@ static void android_app_destroy(struct android_app* android_app) {
     if (android_app->inputQueue != NULL) {
         AInputQueue_detachLooper(android_app->inputQueue);
     }
+    AConfiguration_delete(android_app->prevConfig);
     AConfiguration_delete(android_app->config);
     android_app->destroyed = 1;
     pthread_cond_broadcast(&android_app->cond);
@@ -178,31 +352,441 @@ static void android_app_destroy(struct android_app* android_app) {
     // Can't touch android_app object after this.
 }
 
+// Capture one event into the current fill buffer.  Only the fields in
+// android_input_record survive; the AInputEvent is finished by the
+// caller right after this returns.
+static void record_input_event(struct android_input_buffer* buf, AInputEvent* event) {
+    if (buf->count >= NATIVE_APP_GLUE_INPUT_RECORD_BUFFER_SIZE) {
+        buf->overflow++;
+        return;
+    }
+    struct android_input_record* r = &buf->records[buf->count++];
+    r->type = AInputEvent_getType(event);
+    r->source = AInputEvent_getSource(event);
+    if (r->type == AINPUT_EVENT_TYPE_MOTION) {
+        r->action = AMotionEvent_getAction(event);
+        r->keyCode = 0;
+        r->metaState = AMotionEvent_getMetaState(event);
+        r->eventTimeNs = AMotionEvent_getEventTime(event);
+        size_t pointerCount = AMotionEvent_getPointerCount(event);
+        r->pointerCount = (int32_t)pointerCount;
+        if (pointerCount > NATIVE_APP_GLUE_INPUT_RECORD_POINTERS) {
+            pointerCount = NATIVE_APP_GLUE_INPUT_RECORD_POINTERS;
+        }
+        for (size_t i = 0; i < pointerCount; i++) {
+            r->pointerIds[i] = AMotionEvent_getPointerId(event, i);
+            r->x[i] = AMotionEvent_getX(event, i);
+            r->y[i] = AMotionEvent_getY(event, i);
+            r->pressure[i] = AMotionEvent_getPressure(event, i);
+        }
+    } else {
+        r->action = AKeyEvent_getAction(event);
+        r->keyCode = AKeyEvent_getKeyCode(event);
+        r->metaState = AKeyEvent_getMetaState(event);
+        r->eventTimeNs = AKeyEvent_getEventTime(event);
+        r->pointerCount = 0;
+    }
+}
+
+void android_app_set_input_record_mode(struct android_app* android_app, int enabled) {
+    android_app->inputRecordMode = enabled;
+    android_app->inputBufferFillIndex = 0;
+    android_app->inputBuffers[0].count = 0;
+    android_app->inputBuffers[0].overflow = 0;
+    android_app->inputBuffers[1].count = 0;
+    android_app->inputBuffers[1].overflow = 0;
+}
+
+struct android_input_buffer* android_app_swap_input_buffers(
+        struct android_app* android_app) {
+    struct android_input_buffer* full =
+            &android_app->inputBuffers[android_app->inputBufferFillIndex];
+    android_app->inputBufferFillIndex ^= 1;
+    struct android_input_buffer* fill =
+            &android_app->inputBuffers[android_app->inputBufferFillIndex];
+    fill->count = 0;
+    fill->overflow = 0;
+    return full;
+}
+
 static void process_input(struct android_app* app, struct android_poll_source* source) {
     AInputEvent* event = NULL;
+
+#ifdef NDK_GLUE_ENABLE_TRACING
+    uint64_t drained = 0;
+    app->stats.inputWakeups++;
+#endif
+
+    if (app->inputRecordMode) {
+        // Record mode: copy each event into the fill buffer and finish
+        // it immediately; the app scans the records once per frame
+        // after android_app_swap_input_buffers().
+        struct android_input_buffer* buf =
+                &app->inputBuffers[app->inputBufferFillIndex];
+        while (AInputQueue_getEvent(app->inputQueue, &event) >= 0) {
+            if (AInputQueue_preDispatchEvent(app->inputQueue, event)) {
+                continue;
+            }
+            record_input_event(buf, event);
+            // Motions are consumed by the scan; keys stay unhandled so
+            // system defaults (back key, volume) keep working.
+            AInputQueue_finishEvent(app->inputQueue, event,
+                    AInputEvent_getType(event) == AINPUT_EVENT_TYPE_MOTION);
+#ifdef NDK_GLUE_ENABLE_TRACING
+            drained++;
+#endif
+        }
+#ifdef NDK_GLUE_ENABLE_TRACING
+        app->stats.inputEventsProcessed += drained;
+        if (drained > app->stats.maxEventsPerWakeup) {
+            app->stats.maxEventsPerWakeup = drained;
+        }
+#endif
+        return;
+    }
+
+    if (app->onInputEventsBatch != NULL) {
+        // Batched mode: drain the whole queue into an array and hand it
+        // to the app in one call, finishing every event afterwards.
+        AInputEvent* events[NATIVE_APP_GLUE_MAX_INPUT_BATCH];
+        int32_t handled[NATIVE_APP_GLUE_MAX_INPUT_BATCH];
+        int32_t count;
+        do {
+            count = 0;
+            while (count < NATIVE_APP_GLUE_MAX_INPUT_BATCH &&
+                    AInputQueue_getEvent(app->inputQueue, &event) >= 0) {
+                LOGV("New input event: type=%d", AInputEvent_getType(event));
+                if (AInputQueue_preDispatchEvent(app->inputQueue, event)) {
+                    continue;
+                }
+                events[count] = event;
+                handled[count] = 0;
+                count++;
+            }
+            if (count > 0) {
+                GLUE_TRACE_BEGIN("glue:onInputEventsBatch");
+                app->onInputEventsBatch(app, events, count, handled);
+                GLUE_TRACE_END();
+                for (int32_t i = 0; i < count; i++) {
+                    AInputQueue_finishEvent(app->inputQueue, events[i], handled[i]);
+                }
+#ifdef NDK_GLUE_ENABLE_TRACING
+                drained += (uint64_t)count;
+#endif
+            }
+            // A full batch means there may be more events pending.
+        } while (count == NATIVE_APP_GLUE_MAX_INPUT_BATCH);
+#ifdef NDK_GLUE_ENABLE_TRACING
+        app->stats.inputEventsProcessed += drained;
+        if (drained > app->stats.maxEventsPerWakeup) {
+            app->stats.maxEventsPerWakeup = drained;
+        }
+#endif
+        return;
+    }
+
     while (AInputQueue_getEvent(app->inputQueue, &event) >= 0) {
         LOGV("New input event: type=%d", AInputEvent_getType(event));
         if (AInputQueue_preDispatchEvent(app->inputQueue, event)) {
             continue;
         }
         int32_t handled = 0;
-        if (app->onInputEvent != NULL) handled = app->onInputEvent(app, event);
+        if (app->onInputEvent != NULL) {
+            GLUE_TRACE_BEGIN("glue:onInputEvent");
+            handled = app->onInputEvent(app, event);
+            GLUE_TRACE_END();
+        }
         AInputQueue_finishEvent(app->inputQueue, event, handled);
+#ifdef NDK_GLUE_ENABLE_TRACING
+        drained++;
+#endif
     }
+#ifdef NDK_GLUE_ENABLE_TRACING
+    app->stats.inputEventsProcessed += drained;
+    if (drained > app->stats.maxEventsPerWakeup) {
+        app->stats.maxEventsPerWakeup = drained;
+    }
+#endif
 }
 
 static void process_cmd(struct android_app* app, struct android_poll_source* source) {
-    int8_t cmd = android_app_read_cmd(app);
-    android_app_pre_exec_cmd(app, cmd);
-    if (app->onAppCmd != NULL) app->onAppCmd(app, cmd);
-    android_app_post_exec_cmd(app, cmd);
+#ifdef NDK_GLUE_ENABLE_TRACING
+    app->stats.cmdQueueDepth =
+            __atomic_load_n(&app->cmdRingTail, __ATOMIC_ACQUIRE) -
+            __atomic_load_n(&app->cmdRingHead, __ATOMIC_RELAXED);
+#endif
+    // A single wakeup may cover a burst of commands; drain them all.
+    int8_t cmd;
+    while ((cmd = android_app_read_cmd(app)) >= 0) {
+        GLUE_TRACE_BEGIN("glue:pre_exec_cmd");
+        android_app_pre_exec_cmd(app, cmd);
+        GLUE_TRACE_END();
+        if (app->onAppCmd != NULL) {
+            GLUE_TRACE_BEGIN("glue:onAppCmd");
+            app->onAppCmd(app, cmd);
+            GLUE_TRACE_END();
+        }
+        GLUE_TRACE_BEGIN("glue:post_exec_cmd");
+        android_app_post_exec_cmd(app, cmd);
+        GLUE_TRACE_END();
+    }
+}
+
+// --------------------------------------------------------------------
+// Vsync frame pacing
+// --------------------------------------------------------------------
+
+// AChoreographer appeared in API 24 but this library builds against the
+// minimum supported API level, so the symbols are resolved at runtime
+// from the already-loaded libandroid.
+struct AChoreographer;
+typedef void (*vsync_frame_callback)(long frameTimeNanos, void* data);
+typedef void (*vsync_frame_callback64)(int64_t frameTimeNanos, void* data);
+
+static struct AChoreographer* (*choreographer_get_instance)(void);
+static void (*choreographer_post_frame_callback)(struct AChoreographer*,
+        vsync_frame_callback, void*);
+static void (*choreographer_post_frame_callback64)(struct AChoreographer*,
+        vsync_frame_callback64, void*);
+static pthread_once_t choreographer_once = PTHREAD_ONCE_INIT;
+
+static void resolve_choreographer(void) {
+    choreographer_get_instance = (struct AChoreographer* (*)(void))
+            dlsym(RTLD_DEFAULT, "AChoreographer_getInstance");
+    choreographer_post_frame_callback64 =
+            (void (*)(struct AChoreographer*, vsync_frame_callback64, void*))
+            dlsym(RTLD_DEFAULT, "AChoreographer_postFrameCallback64");
+    choreographer_post_frame_callback =
+            (void (*)(struct AChoreographer*, vsync_frame_callback, void*))
+            dlsym(RTLD_DEFAULT, "AChoreographer_postFrameCallback");
+}
+
+// Runs on the app thread: the choreographer is bound to the looper of
+// the thread that first called AChoreographer_getInstance().
+static void on_frame_callback64(int64_t frameTimeNanos, void* data) {
+    struct android_app* android_app = (struct android_app*)data;
+    android_app->vsyncPending = 0;
+    android_app->vsyncFrameTimeNanos = frameTimeNanos;
+    uint64_t one = 1;
+    if (write(android_app->vsyncEventFd, &one, sizeof(one)) != sizeof(one)) {
+        LOGE("Failure writing vsync eventfd: %s", strerror(errno));
+    }
+}
+
+// The 32-bit long variant is all that exists on API 24-28.
+static void on_frame_callback(long frameTimeNanos, void* data) {
+    on_frame_callback64((int64_t)frameTimeNanos, data);
+}
+
+// Called from the app thread.  Returns -1 when the device has no
+// usable AChoreographer.
+static int android_app_post_vsync_callback(struct android_app* android_app) {
+    pthread_once(&choreographer_once, resolve_choreographer);
+    if (choreographer_get_instance == NULL) return -1;
+    struct AChoreographer* choreographer = choreographer_get_instance();
+    if (choreographer == NULL) return -1;
+    if (choreographer_post_frame_callback64 != NULL) {
+        choreographer_post_frame_callback64(choreographer, on_frame_callback64,
+                android_app);
+    } else if (choreographer_post_frame_callback != NULL) {
+        choreographer_post_frame_callback(choreographer, on_frame_callback,
+                android_app);
+    } else {
+        return -1;
+    }
+    android_app->vsyncPending = 1;
+    return 0;
+}
+
+static void process_vsync(struct android_app* app, struct android_poll_source* source) {
+    uint64_t counter;
+    if (read(app->vsyncEventFd, &counter, sizeof(counter)) < 0 &&
+            errno != EAGAIN) {
+        LOGE("Failure reading vsync eventfd: %s", strerror(errno));
+    }
+    if (app->onVsync != NULL) app->onVsync(app, app->vsyncFrameTimeNanos);
+    // Re-arm only after the app has processed this frame, so a slow
+    // frame handler skips vsyncs instead of accumulating callbacks.
+    if (app->vsyncEnabled && !app->vsyncPending) {
+        android_app_post_vsync_callback(app);
+    }
+}
+
+int android_app_set_vsync_enabled(struct android_app* android_app, int enabled) {
+    if (!enabled) {
+        // A callback already in flight still fires; it just is not
+        // re-armed when processed.
+        android_app->vsyncEnabled = 0;
+        return 0;
+    }
+    if (android_app->vsyncEnabled) return 0;
+    if (!android_app->vsyncPending &&
+            android_app_post_vsync_callback(android_app) < 0) {
+        return -1;
+    }
+    android_app->vsyncEnabled = 1;
+    return 0;
+}
+
+static void process_user_source(struct android_app* app, struct android_poll_source* source) {
+    // The android_poll_source is the first member of its slot.
+    struct android_user_poll_source* slot = (struct android_user_poll_source*)source;
+    slot->callback(app, slot->fd, slot->data);
+}
+
+int android_app_add_poll_source(struct android_app* android_app, int fd,
+        int events,
+        void (*callback)(struct android_app* app, int fd, void* data),
+        void* data) {
+    if (callback == NULL || android_app->looper == NULL) return -1;
+    for (int i = 0; i < NATIVE_APP_GLUE_MAX_USER_POLL_SOURCES; i++) {
+        struct android_user_poll_source* slot = &android_app->userPollSources[i];
+        if (slot->callback != NULL) continue;
+        slot->source.id = LOOPER_ID_USER + i;
+        slot->source.app = android_app;
+        slot->source.process = process_user_source;
+        slot->fd = fd;
+        slot->callback = callback;
+        slot->data = data;
+        if (ALooper_addFd(android_app->looper, fd, LOOPER_ID_USER + i,
+                events, NULL, &slot->source) != 1) {
+            LOGE("could not add fd %d to looper", fd);
+            slot->callback = NULL;
+            return -1;
+        }
+        return LOOPER_ID_USER + i;
+    }
+    LOGE("user poll source pool exhausted (%d slots)",
+            NATIVE_APP_GLUE_MAX_USER_POLL_SOURCES);
+    return -1;
+}
+
+int android_app_remove_poll_source(struct android_app* android_app, int fd) {
+    for (int i = 0; i < NATIVE_APP_GLUE_MAX_USER_POLL_SOURCES; i++) {
+        struct android_user_poll_source* slot = &android_app->userPollSources[i];
+        if (slot->callback == NULL || slot->fd != fd) continue;
+        ALooper_removeFd(android_app->looper, fd);
+        slot->callback = NULL;
+        return 0;
+    }
+    return -1;
+}
+
+int android_app_get_poll_timeout(struct android_app* android_app, int timeoutMillis) {
+    int interval = android_app->backgroundPollIntervalMillis;
+    if (interval <= 0) return timeoutMillis;
+    // activityState is only written by android_app_pre_exec_cmd on this
+    // thread, so a plain read is safe here.
+    if (android_app->activityState != APP_CMD_PAUSE &&
+            android_app->activityState != APP_CMD_STOP) {
+        return timeoutMillis;
+    }
+    // A negative timeout already blocks until an event arrives, which
+    // is as coalesced as it gets.
+    if (timeoutMillis < 0) return timeoutMillis;
+    return timeoutMillis > interval ? timeoutMillis : interval;
+}
+
+void android_app_set_background_poll_interval(struct android_app* android_app,
+        int intervalMillis) {
+    android_app->backgroundPollIntervalMillis = intervalMillis;
+}
+
+// --------------------------------------------------------------------
+// App thread scheduling
+// --------------------------------------------------------------------
+
+// Weak imports from the cpufeatures library, resolved when the app
+// links it and NULL otherwise.  Only functions with scalar signatures
+// are used so the glue does not depend on cpu-features.h types.
+extern int android_getCpuCount(void) __attribute__((weak));
+extern int android_getCpuMaxFreqKHz(int cpu_index) __attribute__((weak));
+
+// Expand the ANDROID_APP_AFFINITY_* cluster selectors into a concrete
+// CPU mask using per-core max frequencies.  Returns 0 (leave affinity
+// alone) when the topology cannot be read.
+static uint64_t android_app_resolve_affinity(uint64_t mask) {
+    if (mask != ANDROID_APP_AFFINITY_BIG_CORES &&
+            mask != ANDROID_APP_AFFINITY_LITTLE_CORES) {
+        return mask;
+    }
+    if (android_getCpuCount == NULL || android_getCpuMaxFreqKHz == NULL) {
+        LOGE("cluster affinity requested but cpufeatures is not linked");
+        return 0;
+    }
+    int count = android_getCpuCount();
+    if (count > 64) count = 64;
+    int best = 0;
+    for (int i = 0; i < count; i++) {
+        int freq = android_getCpuMaxFreqKHz(i);
+        if (mask == ANDROID_APP_AFFINITY_BIG_CORES ? freq > best
+                : (freq > 0 && (best == 0 || freq < best))) {
+            best = freq;
+        }
+    }
+    if (best == 0) return 0;
+    uint64_t resolved = 0;
+    for (int i = 0; i < count; i++) {
+        if (android_getCpuMaxFreqKHz(i) == best) resolved |= 1ull << i;
+    }
+    return resolved;
+}
+
+// Runs on the app thread before android_main(), so everything applies
+// to the calling thread and needs no cross-thread permissions.
+static void android_app_apply_sched_config(void) {
+    if (android_app_thread_config == NULL) return;
+
+    struct android_app_sched_config config;
+    config.policy = -1;
+    config.priority = 0;
+    config.affinity_mask = 0;
+    android_app_thread_config(&config);
+
+    uint64_t mask = android_app_resolve_affinity(config.affinity_mask);
+    if (mask != 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int i = 0; i < 64; i++) {
+            if (mask & (1ull << i)) CPU_SET(i, &set);
+        }
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            LOGE("could not set app thread affinity: %s", strerror(errno));
+        }
+    }
+
+    if (config.policy >= 0 && config.policy != SCHED_OTHER) {
+        struct sched_param param;
+        param.sched_priority = config.priority;
+        int err = pthread_setschedparam(pthread_self(), config.policy, &param);
+        if (err != 0) {
+            LOGE("could not set app thread policy %d: %s", config.policy,
+                    strerror(err));
+        }
+    } else if (config.priority != 0) {
+        if (setpriority(PRIO_PROCESS, (id_t)gettid(), config.priority) != 0) {
+            LOGE("could not set app thread priority: %s", strerror(errno));
+        }
+    }
 }
 
 static void* android_app_entry(void* param) {
     struct android_app* android_app = (struct android_app*)param;
 
+    // Unblock the activity thread as early as possible: everything
+    // below only touches app-thread state, and the command ring accepts
+    // writes before the looper attaches (the eventfd wakeup is a
+    // counter, so nothing is lost if commands arrive first).
+    pthread_mutex_lock(&android_app->mutex);
+    android_app->running = 1;
+    pthread_cond_broadcast(&android_app->cond);
+    pthread_mutex_unlock(&android_app->mutex);
+
+    android_app_apply_sched_config();
+
     android_app->config = AConfiguration_new();
     AConfiguration_fromAssetManager(android_app->config, android_app->activity->assetManager);
+    android_app->prevConfig = AConfiguration_new();
 
     print_cur_config(android_app);
 
@@ -212,17 +796,17 @@ static void* android_app_entry(void* param) {
     android_app->inputPollSource.id = LOOPER_ID_INPUT;
     android_app->inputPollSource.app = android_app;
     android_app->inputPollSource.process = process_input;
+    android_app->vsyncPollSource.id = LOOPER_ID_VSYNC;
+    android_app->vsyncPollSource.app = android_app;
+    android_app->vsyncPollSource.process = process_vsync;
 
     ALooper* looper = ALooper_prepare(ALOOPER_PREPARE_ALLOW_NON_CALLBACKS);
-    ALooper_addFd(looper, android_app->msgread, LOOPER_ID_MAIN, ALOOPER_EVENT_INPUT, NULL,
+    ALooper_addFd(looper, android_app->cmdEventFd, LOOPER_ID_MAIN, ALOOPER_EVENT_INPUT, NULL,
             &android_app->cmdPollSource);
+    ALooper_addFd(looper, android_app->vsyncEventFd, LOOPER_ID_VSYNC, ALOOPER_EVENT_INPUT, NULL,
+            &android_app->vsyncPollSource);
     android_app->looper = looper;
 
-    pthread_mutex_lock(&android_app->mutex);
-    android_app->running = 1;
-    pthread_cond_broadcast(&android_app->cond);
-    pthread_mutex_unlock(&android_app->mutex);
-
     android_main(android_app);
 
     android_app_destroy(android_app);
@@ -235,32 +819,51 @@ static void* android_app_entry(void* param) {
 
 static struct android_app* android_app_create(ANativeActivity* activity,
                                               void* savedState, size_t savedStateSize) {
-    struct android_app* android_app = calloc(1, sizeof(struct android_app));
+    // A single arena allocation covers the struct and the saved-state
+    // copy, so launch costs one activity-thread allocation however the
+    // activity is re-created.  sizeof(struct android_app) is a multiple
+    // of the struct's (8-byte) alignment, so the inline state lands
+    // suitably aligned for any use.
+    struct android_app* android_app =
+            calloc(1, sizeof(struct android_app) + savedStateSize);
     android_app->activity = activity;
+    android_app->backgroundPollIntervalMillis = NATIVE_APP_GLUE_BACKGROUND_POLL_MILLIS;
 
     pthread_mutex_init(&android_app->mutex, NULL);
     pthread_cond_init(&android_app->cond, NULL);
 
-    if (savedState != NULL) {
-        android_app->savedState = malloc(savedStateSize);
+    // This copy is imposed by NativeActivity: the incoming buffer still
+    // belongs to the framework and is released as soon as onCreate
+    // returns, so ownership cannot be transferred here.
+    if (savedState != NULL && savedStateSize > 0) {
+        android_app->savedState = (char*)android_app + sizeof(struct android_app);
         android_app->savedStateSize = savedStateSize;
+        android_app->savedStateIsInline = 1;
         memcpy(android_app->savedState, savedState, savedStateSize);
     }
 
-    int msgpipe[2];
-    if (pipe(msgpipe)) {
-        LOGE("could not create pipe: %s", strerror(errno));
+    android_app->cmdEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (android_app->cmdEventFd < 0) {
+        LOGE("could not create command eventfd: %s", strerror(errno));
+        return NULL;
+    }
+
+    android_app->vsyncEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (android_app->vsyncEventFd < 0) {
+        LOGE("could not create vsync eventfd: %s", strerror(errno));
+        close(android_app->cmdEventFd);
         return NULL;
     }
-    android_app->msgread = msgpipe[0];
-    android_app->msgwrite = msgpipe[1];
 
     pthread_attr_t attr;
     pthread_attr_init(&attr);
     pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
     pthread_create(&android_app->thread, &attr, android_app_entry, android_app);
 
-    // Wait for thread to start.
+    // Wait for the thread to exist.  It signals `running` as its first
+    // action, before loading the configuration or preparing the looper,
+    // so this blocks the activity thread for a thread spawn and nothing
+    // more.
     pthread_mutex_lock(&android_app->mutex);
     while (!android_app->running) {
         pthread_cond_wait(&android_app->cond, &android_app->mutex);
@@ -271,8 +874,46 @@ static struct android_app* android_app_create(ANativeActivity* activity,
 }
 
 static void android_app_write_cmd(struct android_app* android_app, int8_t cmd) {
-    if (write(android_app->msgwrite, &cmd, sizeof(cmd)) != sizeof(cmd)) {
-        LOGE("Failure writing android_app cmd: %s", strerror(errno));
+    if (cmd_is_coalescible(cmd)) {
+        uint32_t bit = 1u << cmd;
+        if (__atomic_fetch_or(&android_app->cmdPendingMask, bit,
+                __ATOMIC_SEQ_CST) & bit) {
+            // Already queued and not yet handled; that instance will
+            // observe the state published just before this call.
+#ifdef NDK_GLUE_ENABLE_TRACING
+            __atomic_fetch_add(&android_app->stats.cmdsCoalesced, 1,
+                    __ATOMIC_RELAXED);
+#endif
+            return;
+        }
+    }
+
+    uint32_t tail = __atomic_load_n(&android_app->cmdRingTail, __ATOMIC_RELAXED);
+
+    // Wait for room in the ring.  This can only happen when the app
+    // thread has NATIVE_APP_GLUE_CMD_RING_SIZE commands outstanding; the
+    // old pipe transport would have blocked here too.
+    while (tail - __atomic_load_n(&android_app->cmdRingHead, __ATOMIC_ACQUIRE)
+            >= NATIVE_APP_GLUE_CMD_RING_SIZE) {
+        sched_yield();
+    }
+
+    android_app->cmdRing[tail % NATIVE_APP_GLUE_CMD_RING_SIZE] = (uint8_t)cmd;
+#ifdef NDK_GLUE_ENABLE_TRACING
+    android_app->cmdRingWriteTimeNs[tail % NATIVE_APP_GLUE_CMD_RING_SIZE] =
+            glue_now_ns();
+#endif
+    __atomic_store_n(&android_app->cmdRingTail, tail + 1, __ATOMIC_RELEASE);
+
+    // Wake the looper only when no wakeup is already in flight, so a
+    // burst of commands pays for a single eventfd write.  The consumer
+    // rearms the flag before draining, which makes a lost wakeup
+    // impossible (at worst the looper sees one spurious wakeup).
+    if (__atomic_exchange_n(&android_app->cmdRingSignaled, 1, __ATOMIC_SEQ_CST) == 0) {
+        uint64_t one = 1;
+        if (write(android_app->cmdEventFd, &one, sizeof(one)) != sizeof(one)) {
+            LOGE("Failure writing android_app cmd: %s", strerror(errno));
+        }
     }
 }
 
@@ -318,8 +959,8 @@ static void android_app_free(struct android_app* android_app) {
     }
     pthread_mutex_unlock(&android_app->mutex);
 
-    close(android_app->msgread);
-    close(android_app->msgwrite);
+    close(android_app->vsyncEventFd);
+    close(android_app->cmdEventFd);
     pthread_cond_destroy(&android_app->cond);
     pthread_mutex_destroy(&android_app->mutex);
     free(android_app);
@@ -387,7 +1028,9 @@ static void onContentRectChanged(ANativeActivity* activity, const ARect* r) {
     LOGV("ContentRectChanged: l=%d,t=%d,r=%d,b=%d", r->left, r->top, r->right, r->bottom);
     struct android_app* android_app = ToApp(activity);
     pthread_mutex_lock(&android_app->mutex);
+    state_write_begin(android_app);
     android_app->contentRect = *r;
+    state_write_end(android_app);
     pthread_mutex_unlock(&android_app->mutex);
     android_app_write_cmd(ToApp(activity), APP_CMD_CONTENT_RECT_CHANGED);
 }
@@ -414,7 +1057,16 @@ static void onNativeWindowDestroyed(ANativeActivity* activity, ANativeWindow* wi
 
 static void onNativeWindowRedrawNeeded(ANativeActivity* activity, ANativeWindow* window) {
     LOGV("NativeWindowRedrawNeeded: %p -- %p", activity, window);
-    android_app_write_cmd(ToApp(activity), APP_CMD_WINDOW_REDRAW_NEEDED);
+    struct android_app* android_app = ToApp(activity);
+    // Fast path: let the app satisfy the redraw right here on the
+    // activity thread, skipping the cross-thread hand-off the
+    // compositor would otherwise wait out during window animations.
+    int32_t (*redraw)(struct android_app*, ANativeWindow*) =
+            __atomic_load_n(&android_app->onRedrawNeeded, __ATOMIC_ACQUIRE);
+    if (redraw != NULL && redraw(android_app, window) != 0) {
+        return;
+    }
+    android_app_write_cmd(android_app, APP_CMD_WINDOW_REDRAW_NEEDED);
 }
 
 static void onNativeWindowResized(ANativeActivity* activity, ANativeWindow* window) {
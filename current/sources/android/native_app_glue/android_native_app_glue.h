@@ -19,6 +19,7 @@
 #include <poll.h>
 #include <pthread.h>
 #include <sched.h>
+#include <stdint.h>
 
 #include <android/configuration.h>
 #include <android/looper.h>
@@ -81,6 +82,96 @@ extern "C" {
 
 struct android_app;
 
+/**
+ * Maximum number of input events handed to android_app::onInputEventsBatch
+ * in a single call.  The glue keeps draining the queue until it is empty,
+ * so this only bounds the batch array, not the number of events per wakeup.
+ */
+#define NATIVE_APP_GLUE_MAX_INPUT_BATCH 64
+
+/**
+ * Default background poll coalescing interval, in milliseconds.  See
+ * android_app_get_poll_timeout().
+ */
+#define NATIVE_APP_GLUE_BACKGROUND_POLL_MILLIS 1000
+
+/**
+ * Capacity of the command ring between the activity thread and the app
+ * thread.  Must be a power of two.  The activity thread yields in the
+ * (pathological) case of this many commands queued and unprocessed.
+ */
+#define NATIVE_APP_GLUE_CMD_RING_SIZE 64
+
+/**
+ * Capacity of each input record buffer, and the number of pointers
+ * captured per motion record.  See android_app_set_input_record_mode().
+ */
+#define NATIVE_APP_GLUE_INPUT_RECORD_BUFFER_SIZE 128
+#define NATIVE_APP_GLUE_INPUT_RECORD_POINTERS 4
+
+/**
+ * A compact copy of one input event, captured while draining the
+ * AInputQueue in record mode.  Key events fill keyCode/metaState;
+ * motion events fill the pointer arrays (up to
+ * NATIVE_APP_GLUE_INPUT_RECORD_POINTERS pointers; pointerCount reports
+ * how many the original event carried).
+ */
+struct android_input_record {
+    int32_t type;          // AINPUT_EVENT_TYPE_KEY or _MOTION.
+    int32_t source;        // AINPUT_SOURCE_*.
+    int32_t action;        // AKeyEvent/AMotionEvent action.
+    int32_t keyCode;       // Key events only.
+    int32_t metaState;
+    int32_t pointerCount;  // Motion events only.
+    int64_t eventTimeNs;
+    int32_t pointerIds[NATIVE_APP_GLUE_INPUT_RECORD_POINTERS];
+    float x[NATIVE_APP_GLUE_INPUT_RECORD_POINTERS];
+    float y[NATIVE_APP_GLUE_INPUT_RECORD_POINTERS];
+    float pressure[NATIVE_APP_GLUE_INPUT_RECORD_POINTERS];
+};
+
+/**
+ * One half of the double-buffered input record path.
+ */
+struct android_input_buffer {
+    struct android_input_record records[NATIVE_APP_GLUE_INPUT_RECORD_BUFFER_SIZE];
+    int32_t count;
+    // Events dropped because the buffer filled before the app swapped;
+    // a non-zero value means the app is swapping less than once per
+    // NATIVE_APP_GLUE_INPUT_RECORD_BUFFER_SIZE events.
+    int32_t overflow;
+};
+
+/**
+ * Counters filled in by the glue's hot paths when the glue is compiled
+ * with -DNDK_GLUE_ENABLE_TRACING (which also emits ATrace sections
+ * around command execution and input dispatch).  In the default build
+ * the collection code compiles to nothing and every field stays zero.
+ * The struct itself is always present so the android_app layout does
+ * not depend on the flag.  All fields are maintained on the app thread
+ * except cmdsCoalesced, which the activity thread updates atomically.
+ */
+struct android_app_stats {
+    // Commands handled, and commands absorbed by the coalescing mask.
+    uint64_t cmdsProcessed;
+    uint64_t cmdsCoalesced;
+
+    // Commands found queued at the start of the last LOOPER_ID_MAIN
+    // wakeup.
+    uint32_t cmdQueueDepth;
+
+    // Time from android_app_write_cmd() to handler entry, summed over
+    // cmdsProcessed, plus the worst single command.
+    uint64_t cmdLatencyTotalNs;
+    uint64_t cmdLatencyMaxNs;
+
+    // Input events dispatched, LOOPER_ID_INPUT wakeups, and the largest
+    // number of events drained by one wakeup.
+    uint64_t inputEventsProcessed;
+    uint64_t inputWakeups;
+    uint64_t maxEventsPerWakeup;
+};
+
 /**
  * Data associated with an ALooper fd that will be returned as the "outData"
  * when that source has data ready.
@@ -98,6 +189,30 @@ struct android_poll_source {
     void (*process)(struct android_app* app, struct android_poll_source* source);
 };
 
+/**
+ * Capacity of the pooled user poll source slots.  See
+ * android_app_add_poll_source().
+ */
+#define NATIVE_APP_GLUE_MAX_USER_POLL_SOURCES 8
+
+/**
+ * One pooled slot backing android_app_add_poll_source().  The embedded
+ * android_poll_source is what ALooper_pollOnce() hands back, so user
+ * sources dispatch through the same process() mechanism as the glue's
+ * own.  Each slot is cache-line-aligned: a wakeup touches exactly one
+ * line before the indirect call.
+ */
+struct android_user_poll_source {
+    // Must be first so outData can be cast either way.
+    struct android_poll_source source;
+
+    // The registered fd, callback, and its context.  A slot is free
+    // when callback is NULL.
+    int fd;
+    void (*callback)(struct android_app* app, int fd, void* data);
+    void* data;
+} __attribute__((aligned(64)));
+
 /**
  * This is the interface for the standard glue code of a threaded
  * application.  In this model, the application's code is running
@@ -120,12 +235,51 @@ struct android_app {
     // dispatching.
     int32_t (*onInputEvent)(struct android_app* app, AInputEvent* event);
 
+    // Optional batched alternative to onInputEvent.  When non-NULL, the
+    // glue drains the whole AInputQueue on each looper wakeup and hands
+    // all pending events to this callback in one call (at most
+    // NATIVE_APP_GLUE_MAX_INPUT_BATCH per call), so a frame's worth of
+    // high-rate motion history can be processed without per-event looper
+    // round-trips.  Events have already been pre-dispatched.  Set
+    // handled[i] to 1 for each event you consumed; every event is
+    // finished when the callback returns.  When this is set, onInputEvent
+    // is not called.
+    void (*onInputEventsBatch)(struct android_app* app, AInputEvent** events,
+                               int32_t count, int32_t* handled);
+
+    // Optional redraw fast path.  When non-NULL, the glue calls this
+    // synchronously from onNativeWindowRedrawNeeded -- on the ACTIVITY
+    // thread, which the compositor is waiting on -- instead of queueing
+    // APP_CMD_WINDOW_REDRAW_NEEDED for the app thread.  Return non-zero
+    // once the window content has been made valid (e.g. by re-posting a
+    // retained buffer); return 0 to fall back to the queued command.
+    // The callback must not block on the app thread and must only touch
+    // state safe to read from the activity thread.  Set it before the
+    // first window is created.
+    int32_t (*onRedrawNeeded)(struct android_app* app, ANativeWindow* window);
+
+    // Optional.  When frame pacing is enabled with
+    // android_app_set_vsync_enabled(), this is called on the app thread
+    // once per choreographer frame, through the LOOPER_ID_VSYNC poll
+    // source, with the expected presentation time of the frame in the
+    // CLOCK_MONOTONIC base.
+    void (*onVsync)(struct android_app* app, int64_t frameTimeNanos);
+
     // The ANativeActivity object instance that this app is running in.
     ANativeActivity* activity;
 
     // The current configuration the app is running in.
     AConfiguration* config;
 
+    // Bitmask of ACONFIGURATION_* bits for the fields changed by the
+    // most recent APP_CMD_CONFIG_CHANGED, computed against the previous
+    // configuration before 'config' is repopulated.  An
+    // APP_CMD_CONFIG_CHANGED handler can test the bits it cares about
+    // (e.g. ACONFIGURATION_ORIENTATION | ACONFIGURATION_DENSITY) and
+    // skip requerying everything else.  Zero before the first
+    // configuration change.
+    int32_t configDiff;
+
     // This is the last instance's saved state, as provided at creation time.
     // It is NULL if there was no state.  You can use this as you need; the
     // memory will remain around until you call android_app_exec_cmd() for
@@ -155,25 +309,94 @@ struct android_app {
     // APP_CMD_RESUME, APP_CMD_PAUSE, or APP_CMD_STOP; see below.
     int activityState;
 
+    // Interval used by android_app_get_poll_timeout() to coalesce
+    // looper wakeups while the activity is paused or stopped.  Defaults
+    // to NATIVE_APP_GLUE_BACKGROUND_POLL_MILLIS; <= 0 disables
+    // coalescing.  Only read on the app thread; change it with
+    // android_app_set_background_poll_interval().
+    int backgroundPollIntervalMillis;
+
     // This is non-zero when the application's NativeActivity is being
     // destroyed and waiting for the app thread to complete.
     int destroyRequested;
 
+    // Glue-internal timing counters; see struct android_app_stats.
+    // Zero unless the glue is built with -DNDK_GLUE_ENABLE_TRACING.
+    struct android_app_stats stats;
+
     // -------------------------------------------------
     // Below are "private" implementation of the glue code.
 
     pthread_mutex_t mutex;
     pthread_cond_t cond;
 
-    int msgread;
-    int msgwrite;
+    // Seqlock generation counter for the lifecycle fields read by
+    // android_app_get_state_snapshot() (window, inputQueue, contentRect,
+    // activityState).  Writers hold `mutex` (which serializes them) and
+    // bump this to odd before and even after touching those fields;
+    // readers never take the mutex.
+    uint32_t stateSeq;
+
+    // Command channel: a single-producer/single-consumer ring written by
+    // the activity thread and drained by the app thread.  The eventfd is
+    // only used to wake the ALooper when the ring goes non-empty, so a
+    // burst of commands costs one wakeup instead of one syscall each.
+    int cmdEventFd;
+    uint8_t cmdRing[NATIVE_APP_GLUE_CMD_RING_SIZE];
+    uint32_t cmdRingHead;      // Next slot to read; app thread only.
+    uint32_t cmdRingTail;      // Next slot to write; activity thread only.
+    int cmdRingSignaled;       // Non-zero while a wakeup is in flight.
+
+    // Enqueue timestamps matching cmdRing slots, maintained only when
+    // the glue is built with -DNDK_GLUE_ENABLE_TRACING; feeds the
+    // command latency counters in stats.
+    int64_t cmdRingWriteTimeNs[NATIVE_APP_GLUE_CMD_RING_SIZE];
+
+    // Bitmask (indexed by APP_CMD_* value) of idempotent commands
+    // currently queued in the ring.  Such commands carry their payload
+    // in latest-state fields (e.g. pendingContentRect), so re-sending
+    // one that is already queued is dropped and the queued instance
+    // observes the newest state: a rotation's worth of resize/config
+    // churn collapses into one handler invocation per command.
+    uint32_t cmdPendingMask;
 
     pthread_t thread;
 
     struct android_poll_source cmdPollSource;
     struct android_poll_source inputPollSource;
 
+    // Scratch copy of the previous configuration, diffed against the
+    // fresh one on APP_CMD_CONFIG_CHANGED to produce configDiff.  App
+    // thread only.
+    AConfiguration* prevConfig;
+
+    // Vsync frame pacing (see android_app_set_vsync_enabled).  The
+    // choreographer frame callback runs on the app thread and bounces
+    // the timestamp through this eventfd, so frames are delivered as a
+    // LOOPER_ID_VSYNC poll source like every other glue event.  All of
+    // these are touched from the app thread only.
+    int vsyncEventFd;
+    int vsyncEnabled;
+    int vsyncPending;
+    int64_t vsyncFrameTimeNanos;
+    struct android_poll_source vsyncPollSource;
+
+    // Pooled user poll sources (see android_app_add_poll_source).
+    // App thread only.
+    struct android_user_poll_source userPollSources[NATIVE_APP_GLUE_MAX_USER_POLL_SOURCES];
+
+    // Input record mode (see android_app_set_input_record_mode).  The
+    // buffer at inputBufferFillIndex is filled by process_input; the
+    // other belongs to the app between swaps.  App thread only.
+    int inputRecordMode;
+    int inputBufferFillIndex;
+    struct android_input_buffer inputBuffers[2];
+
     int running;
+    // Non-zero while savedState points into the android_app allocation
+    // (the restore-time copy is placed there to keep launch down to a
+    // single activity-thread allocation) rather than a malloc'd buffer.
+    int savedStateIsInline;
     int stateSaved;
     int destroyed;
     int redrawNeeded;
@@ -202,9 +425,21 @@ enum {
     LOOPER_ID_INPUT = 2,
 
     /**
-     * Start of user-defined ALooper identifiers.
+     * Looper data ID of choreographer frame callbacks, delivered when
+     * vsync pacing has been enabled with android_app_set_vsync_enabled().
+     * The data for this identifier is a pointer to an android_poll_source
+     * structure; processing it invokes android_app::onVsync.
+     */
+    LOOPER_ID_VSYNC = 3,
+
+    /**
+     * Start of user-defined ALooper identifiers.  The glue reserves
+     * LOOPER_ID_USER through LOOPER_ID_USER +
+     * NATIVE_APP_GLUE_MAX_USER_POLL_SOURCES - 1 for sources registered
+     * with android_app_add_poll_source(); identifiers for fds the app
+     * attaches to the looper itself should start above that range.
      */
-    LOOPER_ID_USER = 3,
+    LOOPER_ID_USER = 4,
 };
 
 enum {
@@ -309,9 +544,189 @@ enum {
     APP_CMD_DESTROY,
 };
 
+/**
+ * Take ownership of the restored saved state buffer, instead of copying
+ * it out of android_app::savedState before the glue frees it on
+ * APP_CMD_RESUME.  On return, android_app::savedState is NULL and the
+ * caller owns the buffer, which must be released with free().  Returns
+ * NULL (and sets *outSize to 0) when there is no saved state.
+ *
+ * Note that the save direction is already zero-copy: the buffer the app
+ * places in android_app::savedState during APP_CMD_SAVE_STATE is handed
+ * to the system without duplication.
+ */
+void* android_app_take_saved_state(struct android_app* android_app, size_t* outSize);
+
+/**
+ * Enable or disable vsync-driven frame pacing.  While enabled, the
+ * looper wakes with LOOPER_ID_VSYNC once per display frame and the
+ * standard processing invokes android_app::onVsync with the expected
+ * presentation timestamp, so a render loop can block in
+ * ALooper_pollAll(-1) instead of spinning with a zero timeout.  The
+ * next frame callback is armed only after the previous one has been
+ * processed; a slow frame handler skips vsyncs rather than building a
+ * backlog.
+ *
+ * Must be called from the app thread.  Returns 0 on success, or -1
+ * when AChoreographer is not available (the glue builds against the
+ * minimum API level and resolves it at runtime, so this fails on
+ * devices before API 24).
+ */
+int android_app_set_vsync_enabled(struct android_app* android_app, int enabled);
+
+/**
+ * A coherent copy of the lifecycle state, taken without locking.  See
+ * android_app_get_state_snapshot().
+ */
+struct android_app_state_snapshot {
+    ANativeWindow* window;
+    AInputQueue* inputQueue;
+    ARect contentRect;
+    int activityState;
+};
+
+/**
+ * Read a consistent {window, inputQueue, contentRect, activityState}
+ * tuple without taking android_app::mutex, so a render loop polling
+ * this every frame never contends with the activity thread's
+ * android_app_set_* handshakes.  Internally a seqlock: writers publish
+ * new versions without blocking readers, and a reader only retries in
+ * the rare case a write was in flight.
+ *
+ * The snapshot is a point-in-time copy; the window and input queue it
+ * contains may be torn down afterwards, which the app observes through
+ * the usual APP_CMD_TERM_WINDOW / APP_CMD_INPUT_CHANGED commands.
+ */
+void android_app_get_state_snapshot(struct android_app* android_app,
+        struct android_app_state_snapshot* snapshot);
+
+/**
+ * Register an fd with the app's looper, dispatched through the same
+ * android_poll_source::process() mechanism as LOOPER_ID_MAIN and
+ * LOOPER_ID_INPUT: when ALooper_pollOnce() returns this source's
+ * identifier, calling process() on the returned android_poll_source
+ * invokes the given callback.  Slots come from a fixed pool of
+ * cache-line-aligned entries inside android_app, so multi-fd event
+ * loops get one predictable indirect call per wakeup and no per-source
+ * heap allocation.
+ *
+ * Returns the looper identifier assigned to the source
+ * (LOOPER_ID_USER + slot index), or -1 when the pool of
+ * NATIVE_APP_GLUE_MAX_USER_POLL_SOURCES slots is exhausted or the fd
+ * could not be added to the looper.  Must be called from the app
+ * thread after the looper exists (i.e. from android_main onwards).
+ */
+int android_app_add_poll_source(struct android_app* android_app, int fd,
+        int events,
+        void (*callback)(struct android_app* app, int fd, void* data),
+        void* data);
+
+/**
+ * Unregister an fd added with android_app_add_poll_source() and free
+ * its slot.  Returns 0 on success, -1 when the fd is not registered.
+ * Must be called from the app thread.
+ */
+int android_app_remove_poll_source(struct android_app* android_app, int fd);
+
+/**
+ * Switch input delivery to the double-buffered record path.  While
+ * enabled, draining LOOPER_ID_INPUT copies each event into a compact
+ * android_input_record in the current fill buffer and finishes it
+ * immediately, instead of invoking onInputEvent/onInputEventsBatch; the
+ * looper wakeup degenerates to a "data available" signal.  The app
+ * scans a frame's worth of events in one pass by calling
+ * android_app_swap_input_buffers() once per frame.
+ *
+ * Motion events are finished as handled; key events are finished as
+ * unhandled so system defaults (e.g. the back key) still apply.  Apps
+ * that need full per-pointer history should stay on the callback path.
+ *
+ * Must be called from the app thread.
+ */
+void android_app_set_input_record_mode(struct android_app* android_app, int enabled);
+
+/**
+ * Swap the input record buffers and return the one filled since the
+ * previous swap.  The returned buffer (count records, plus an overflow
+ * count of events dropped while it was filling) stays valid until the
+ * next swap.  Call once per frame from the app thread while record
+ * mode is enabled.
+ */
+struct android_input_buffer* android_app_swap_input_buffers(
+        struct android_app* android_app);
+
+/**
+ * Timeout to pass to ALooper_pollAll()/ALooper_pollOnce() from the
+ * app's event loop, given the timeout the app would otherwise use.
+ * While the activity is started or resumed the requested timeout is
+ * returned unchanged.  Once activityState is APP_CMD_PAUSE or
+ * APP_CMD_STOP, finite timeouts are stretched to at least
+ * android_app::backgroundPollIntervalMillis, so timer- and sensor-
+ * driven LOOPER_ID_USER work batches into coalesced windows instead of
+ * waking a backgrounded app at full rate.  Lifecycle commands still
+ * wake the looper immediately through the command eventfd, so delivery
+ * snaps back to normal on APP_CMD_RESUME with no added latency.
+ *
+ * Must be called from the app thread.
+ */
+int android_app_get_poll_timeout(struct android_app* android_app, int timeoutMillis);
+
+/**
+ * Change the background coalescing interval used by
+ * android_app_get_poll_timeout().  Pass 0 (or a negative value) to
+ * disable coalescing.  Must be called from the app thread.
+ */
+void android_app_set_background_poll_interval(struct android_app* android_app,
+        int intervalMillis);
+
+/**
+ * Scheduling configuration for the app thread.  See
+ * android_app_thread_config() below.
+ */
+struct android_app_sched_config {
+    // SCHED_* scheduling policy for the app thread, or -1 to keep the
+    // default policy.
+    int policy;
+
+    // For real-time policies, the sched_priority value; for the default
+    // policy, the nice value applied with setpriority() (negative is
+    // more favorable).  0 keeps the default.
+    int priority;
+
+    // CPU affinity mask for the app thread; bit N selects CPU N.  0
+    // keeps the default (all cores).  The special values below select
+    // cores by cluster, using the CPU topology from the cpufeatures
+    // library when the application links it.
+    uint64_t affinity_mask;
+};
+
+/**
+ * Affinity mask values selecting the highest-clocked (big) or
+ * lowest-clocked (LITTLE) cores.  They resolve against the cpufeatures
+ * library, which the glue imports weakly: when the app does not link
+ * cpufeatures, or the device topology cannot be read, the affinity is
+ * left untouched.
+ */
+#define ANDROID_APP_AFFINITY_BIG_CORES    ((uint64_t)-1)
+#define ANDROID_APP_AFFINITY_LITTLE_CORES ((uint64_t)-2)
+
+/**
+ * Optionally define this function in your application to control how
+ * the app thread is scheduled.  The glue declares it weak: when it is
+ * defined, it is called on the app thread right after the thread is
+ * spawned -- before android_main() -- with a config preset to "keep
+ * everything default", and whatever it fills in is applied immediately.
+ * This runs before any app code, so a game loop can start on big cores
+ * at elevated priority instead of paying the migration cost during its
+ * first seconds.
+ */
+extern void android_app_thread_config(struct android_app_sched_config* config)
+        __attribute__((weak));
+
 /**
  * Call when ALooper_pollAll() returns LOOPER_ID_MAIN, reading the next
- * app command message.
+ * app command message.  A single looper wakeup may cover several queued
+ * commands; call this in a loop until it returns -1 (no more commands).
  */
 int8_t android_app_read_cmd(struct android_app* android_app);
 
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "android_native_app_glue.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+// Benchmarks for the glue's command channel. android_app_write_cmd is
+// internal to the glue, so the producer side replicates its ring/eventfd
+// protocol against the public fields of struct android_app; keep the two
+// in sync when the transport changes.
+
+// The glue's object file carries an undefined reference to the app
+// entry point; these benchmarks drive the command channel directly and
+// never spawn the app thread, so a stub satisfies the linker.
+extern "C" void android_main(struct android_app*) {}
+
+static android_app* CreateTestApp() {
+    android_app* app = static_cast<android_app*>(calloc(1, sizeof(android_app)));
+    pthread_mutex_init(&app->mutex, nullptr);
+    pthread_cond_init(&app->cond, nullptr);
+    app->cmdEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return app;
+}
+
+static void DestroyTestApp(android_app* app) {
+    close(app->cmdEventFd);
+    pthread_cond_destroy(&app->cond);
+    pthread_mutex_destroy(&app->mutex);
+    free(app);
+}
+
+// Producer-side mirror of android_app_write_cmd.
+static bool CmdIsCoalescible(int8_t cmd) {
+    switch (cmd) {
+        case APP_CMD_WINDOW_RESIZED:
+        case APP_CMD_WINDOW_REDRAW_NEEDED:
+        case APP_CMD_CONTENT_RECT_CHANGED:
+        case APP_CMD_CONFIG_CHANGED:
+        case APP_CMD_LOW_MEMORY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void WriteCmd(android_app* app, int8_t cmd) {
+    if (CmdIsCoalescible(cmd)) {
+        uint32_t bit = 1u << cmd;
+        if (__atomic_fetch_or(&app->cmdPendingMask, bit, __ATOMIC_SEQ_CST) & bit) {
+            return;
+        }
+    }
+    uint32_t tail = __atomic_load_n(&app->cmdRingTail, __ATOMIC_RELAXED);
+    while (tail - __atomic_load_n(&app->cmdRingHead, __ATOMIC_ACQUIRE) >=
+           NATIVE_APP_GLUE_CMD_RING_SIZE) {
+        sched_yield();
+    }
+    app->cmdRing[tail % NATIVE_APP_GLUE_CMD_RING_SIZE] = (uint8_t)cmd;
+    __atomic_store_n(&app->cmdRingTail, tail + 1, __ATOMIC_RELEASE);
+    if (__atomic_exchange_n(&app->cmdRingSignaled, 1, __ATOMIC_SEQ_CST) == 0) {
+        uint64_t one = 1;
+        if (write(app->cmdEventFd, &one, sizeof(one)) != sizeof(one)) {
+            abort();
+        }
+    }
+}
+
+static void DrainCmds(android_app* app) {
+    int8_t cmd;
+    while ((cmd = android_app_read_cmd(app)) >= 0) {
+        android_app_pre_exec_cmd(app, cmd);
+        android_app_post_exec_cmd(app, cmd);
+    }
+}
+
+// Single-command round trip: write, wake, read, pre/post exec.
+// APP_CMD_GAINED_FOCUS has no special pre/post handling, so this
+// measures pure channel overhead.
+static void BM_CmdRoundTrip(benchmark::State& state) {
+    android_app* app = CreateTestApp();
+    for (auto _ : state) {
+        WriteCmd(app, APP_CMD_GAINED_FOCUS);
+        DrainCmds(app);
+    }
+    DestroyTestApp(app);
+}
+BENCHMARK(BM_CmdRoundTrip);
+
+// Burst of commands followed by one drain, the shape a rotation or
+// window churn produces. With the ring transport the burst should cost
+// a single eventfd wakeup.
+static void BM_CmdBurst16(benchmark::State& state) {
+    android_app* app = CreateTestApp();
+    for (auto _ : state) {
+        for (int n = 0; n < 16; n++) {
+            WriteCmd(app, APP_CMD_GAINED_FOCUS);
+        }
+        DrainCmds(app);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(16);
+    DestroyTestApp(app);
+}
+BENCHMARK(BM_CmdBurst16);
+
+// Burst of idempotent commands, the rotation/window-churn case the
+// coalescing mask exists for: all but the first write collapse into a
+// bit test, and the drain sees a single command.
+static void BM_CmdCoalescedBurst16(benchmark::State& state) {
+    android_app* app = CreateTestApp();
+    for (auto _ : state) {
+        for (int n = 0; n < 16; n++) {
+            WriteCmd(app, APP_CMD_WINDOW_RESIZED);
+        }
+        DrainCmds(app);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(16);
+    DestroyTestApp(app);
+}
+BENCHMARK(BM_CmdCoalescedBurst16);
+
+// Lifecycle state commands take the pre-exec mutex/condvar path.
+static void BM_CmdActivityState(benchmark::State& state) {
+    android_app* app = CreateTestApp();
+    for (auto _ : state) {
+        WriteCmd(app, APP_CMD_START);
+        WriteCmd(app, APP_CMD_RESUME);
+        WriteCmd(app, APP_CMD_PAUSE);
+        WriteCmd(app, APP_CMD_STOP);
+        DrainCmds(app);
+    }
+    state.SetItemsProcessed(4);
+    DestroyTestApp(app);
+}
+BENCHMARK(BM_CmdActivityState);
+
+BENCHMARK_MAIN();
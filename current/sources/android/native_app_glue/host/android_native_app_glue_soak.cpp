@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host soak harness for android_native_app_glue. Runs the real glue --
+// ANativeActivity_onCreate, the app thread, the command ring, the
+// looper -- against the functional shims in host_shim.c, and replays
+// the storms that hurt on devices: rapid pause/resume cycles, rotation
+// bursts, and input floods. Reports per-command latency percentiles
+// (activity-thread send to app-thread handler) and wakeup counts, so a
+// transport regression shows up here instead of on user devices.
+//
+// Usage: android_native_app_glue_soak [iterations]  (default 1000)
+
+#include "android_native_app_glue.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_shim.h"
+
+static int64_t NowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+}
+
+static const char* const kCmdNames[] = {
+    "INPUT_CHANGED",       "INIT_WINDOW",    "TERM_WINDOW",
+    "WINDOW_RESIZED",      "REDRAW_NEEDED",  "CONTENT_RECT_CHANGED",
+    "GAINED_FOCUS",        "LOST_FOCUS",     "CONFIG_CHANGED",
+    "LOW_MEMORY",          "START",          "RESUME",
+    "SAVE_STATE",          "PAUSE",          "STOP",
+    "DESTROY",
+};
+static const int kCmdCount = sizeof(kCmdNames) / sizeof(kCmdNames[0]);
+
+// Send timestamp per command, stamped on the activity thread just
+// before the callback that enqueues it, consumed by the app-thread
+// handler. When the glue coalesces a burst, the surviving instance
+// measures from the most recent send -- which is exactly the latency an
+// app perceives for the state it ends up rendering.
+static int64_t g_cmdSendTimeNs[kCmdCount];
+
+// Latency samples per command. Written only by the app thread; read by
+// the main thread after the app thread has been torn down.
+static std::vector<int64_t> g_cmdLatencyNs[kCmdCount];
+
+// Looper wakeups observed by the app thread's poll loop.
+static int64_t g_wakeups;
+
+static int64_t g_inputEventsHandled;
+
+// CONFIG_CHANGED handlers whose android_app::configDiff ORIENTATION bit
+// agreed with the orientation delta the handler actually observed. The
+// bit alone is not checkable: a coalesced burst that nets back to the
+// starting orientation correctly reports no change, so agreement with
+// the observed delta is what counts. The quiesced flip at the end of
+// the rotation storm guarantees at least one delivery carries a real
+// delta, so "ok" can never be trivially zero.
+static int64_t g_configDiffOk;
+static int64_t g_configDiffMismatches;
+
+// Orientation at the previous CONFIG_CHANGED delivery (seeded from the
+// startup configuration in android_main). App thread only, matching
+// the glue's own prevConfig baseline.
+static int32_t g_lastSeenOrientation;
+
+static void StampCmd(int8_t cmd) {
+    __atomic_store_n(&g_cmdSendTimeNs[cmd], NowNs(), __ATOMIC_RELEASE);
+}
+
+static void OnAppCmd(android_app* app, int32_t cmd) {
+    if (cmd < 0 || cmd >= kCmdCount) {
+        return;
+    }
+    if (cmd == APP_CMD_CONFIG_CHANGED) {
+        int32_t orientation = AConfiguration_getOrientation(app->config);
+        bool flagged = (app->configDiff & ACONFIGURATION_ORIENTATION) != 0;
+        bool changed = orientation != g_lastSeenOrientation;
+        if (flagged == changed) {
+            g_configDiffOk++;
+        } else {
+            g_configDiffMismatches++;
+        }
+        g_lastSeenOrientation = orientation;
+    }
+    int64_t sent = __atomic_load_n(&g_cmdSendTimeNs[cmd], __ATOMIC_ACQUIRE);
+    if (sent != 0) {
+        g_cmdLatencyNs[cmd].push_back(NowNs() - sent);
+    }
+}
+
+static int32_t OnInputEvent(android_app* app, AInputEvent* event) {
+    (void)app;
+    (void)event;
+    g_inputEventsHandled++;
+    return 1;
+}
+
+// The app thread: the canonical android_main loop from the glue's
+// documentation, with a wakeup counter bolted on.
+extern "C" void android_main(struct android_app* app) {
+    app->onAppCmd = OnAppCmd;
+    app->onInputEvent = OnInputEvent;
+    g_lastSeenOrientation = AConfiguration_getOrientation(app->config);
+
+    while (!app->destroyRequested) {
+        int events = 0;
+        void* data = nullptr;
+        int ident = ALooper_pollOnce(-1, nullptr, &events, &data);
+        if (ident >= 0) {
+            __atomic_fetch_add(&g_wakeups, 1, __ATOMIC_RELAXED);
+            android_poll_source* source = static_cast<android_poll_source*>(data);
+            if (source != nullptr) {
+                source->process(app, source);
+            }
+        }
+    }
+}
+
+// Wait until every queued command has been handled. The final blocking
+// handshake (activity-state commands, window commands) already provides
+// this for the lifecycle scenarios; the ring check covers the
+// non-blocking ones.
+static void Quiesce(android_app* app) {
+    while (__atomic_load_n(&app->cmdRingHead, __ATOMIC_ACQUIRE) !=
+           __atomic_load_n(&app->cmdRingTail, __ATOMIC_ACQUIRE)) {
+        usleep(100);
+    }
+    // The last command may still be inside its handler; one more
+    // round trip through a blocking command closes the window.
+    usleep(1000);
+}
+
+// Scenario 1: pause/resume churn, the pattern of notification shades
+// and quick app switches. Every command here takes the blocking
+// activity-state handshake, so latency covers the full cross-thread
+// round trip.
+static void RunLifecycleStorm(ANativeActivity* activity, int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        StampCmd(APP_CMD_PAUSE);
+        activity->callbacks->onPause(activity);
+        StampCmd(APP_CMD_STOP);
+        activity->callbacks->onStop(activity);
+        StampCmd(APP_CMD_START);
+        activity->callbacks->onStart(activity);
+        StampCmd(APP_CMD_RESUME);
+        activity->callbacks->onResume(activity);
+    }
+}
+
+// Scenario 2: rotation storm. Each iteration flips the simulated
+// device orientation and raises the burst a rotation produces; the
+// commands are coalescible, so this also exercises the pending-mask
+// path under contention.
+static void RunRotationStorm(android_app* app, ANativeActivity* activity,
+                             ANativeWindow* window, int iterations) {
+    AConfiguration* device = host_device_configuration();
+    ARect rect = { 0, 0, 1080, 1920 };
+
+    for (int i = 0; i < iterations; i++) {
+        AConfiguration_setOrientation(device, (i & 1)
+                ? ACONFIGURATION_ORIENTATION_PORT
+                : ACONFIGURATION_ORIENTATION_LAND);
+        StampCmd(APP_CMD_CONFIG_CHANGED);
+        activity->callbacks->onConfigurationChanged(activity);
+        StampCmd(APP_CMD_WINDOW_RESIZED);
+        activity->callbacks->onNativeWindowResized(activity, window);
+        std::swap(rect.right, rect.bottom);
+        StampCmd(APP_CMD_CONTENT_RECT_CHANGED);
+        activity->callbacks->onContentRectChanged(activity, &rect);
+    }
+
+    // One quiesced flip to close: delivered on its own, it cannot
+    // coalesce with the burst, so exactly this delivery is guaranteed
+    // to observe a real orientation delta in configDiff.
+    Quiesce(app);
+    AConfiguration_setOrientation(
+            device, AConfiguration_getOrientation(device) ==
+                            ACONFIGURATION_ORIENTATION_PORT
+                    ? ACONFIGURATION_ORIENTATION_LAND
+                    : ACONFIGURATION_ORIENTATION_PORT);
+    StampCmd(APP_CMD_CONFIG_CHANGED);
+    activity->callbacks->onConfigurationChanged(activity);
+}
+
+// Scenario 3: input flood, delivered in frame-sized bursts like a
+// high-rate touchscreen. Wakeups and batching behavior come from the
+// glue's own stats (tracing build).
+static void RunInputFlood(ANativeActivity* activity, int bursts, int perBurst) {
+    AInputQueue* queue = host_input_queue_create();
+    activity->callbacks->onInputQueueCreated(activity, queue);
+
+    for (int b = 0; b < bursts; b++) {
+        for (int i = 0; i < perBurst; i++) {
+            host_input_queue_push_motion(queue, AMOTION_EVENT_ACTION_MOVE,
+                                         static_cast<float>(i),
+                                         static_cast<float>(b));
+        }
+        while (host_input_queue_outstanding(queue) > 0) {
+            usleep(100);
+        }
+    }
+
+    activity->callbacks->onInputQueueDestroyed(activity, queue);
+    host_input_queue_destroy(queue);
+}
+
+static int64_t Percentile(std::vector<int64_t>& samples, double p) {
+    size_t index = static_cast<size_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+static void ReportLatencies() {
+    printf("%-22s %8s %9s %9s %9s %9s\n",
+           "command", "count", "p50_us", "p90_us", "p99_us", "max_us");
+    for (int cmd = 0; cmd < kCmdCount; cmd++) {
+        std::vector<int64_t>& samples = g_cmdLatencyNs[cmd];
+        if (samples.empty()) {
+            continue;
+        }
+        int64_t max = *std::max_element(samples.begin(), samples.end());
+        printf("%-22s %8zu %9.1f %9.1f %9.1f %9.1f\n",
+               kCmdNames[cmd], samples.size(),
+               Percentile(samples, 0.50) / 1e3,
+               Percentile(samples, 0.90) / 1e3,
+               Percentile(samples, 0.99) / 1e3,
+               max / 1e3);
+    }
+}
+
+int main(int argc, char** argv) {
+    int iterations = 1000;
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ANativeActivityCallbacks callbacks;
+    memset(&callbacks, 0, sizeof(callbacks));
+    ANativeActivity activity;
+    memset(&activity, 0, sizeof(activity));
+    activity.callbacks = &callbacks;
+    activity.sdkVersion = 24;
+
+    // Opaque token; the glue stores it but never dereferences it.
+    static int windowToken;
+    ANativeWindow* window = reinterpret_cast<ANativeWindow*>(&windowToken);
+
+    ANativeActivity_onCreate(&activity, nullptr, 0);
+    android_app* app = static_cast<android_app*>(activity.instance);
+
+    // Bring the activity to the foreground the way the framework would.
+    StampCmd(APP_CMD_START);
+    callbacks.onStart(&activity);
+    StampCmd(APP_CMD_RESUME);
+    callbacks.onResume(&activity);
+    StampCmd(APP_CMD_INIT_WINDOW);
+    callbacks.onNativeWindowCreated(&activity, window);
+    StampCmd(APP_CMD_GAINED_FOCUS);
+    callbacks.onWindowFocusChanged(&activity, 1);
+    Quiesce(app);
+
+    int64_t wakeupsBefore;
+
+    wakeupsBefore = __atomic_load_n(&g_wakeups, __ATOMIC_RELAXED);
+    RunLifecycleStorm(&activity, iterations);
+    Quiesce(app);
+    int64_t lifecycleWakeups =
+            __atomic_load_n(&g_wakeups, __ATOMIC_RELAXED) - wakeupsBefore;
+
+    wakeupsBefore = __atomic_load_n(&g_wakeups, __ATOMIC_RELAXED);
+    RunRotationStorm(app, &activity, window, iterations);
+    Quiesce(app);
+    int64_t rotationWakeups =
+            __atomic_load_n(&g_wakeups, __ATOMIC_RELAXED) - wakeupsBefore;
+
+    const int kEventsPerBurst = 32;
+    wakeupsBefore = __atomic_load_n(&g_wakeups, __ATOMIC_RELAXED);
+    RunInputFlood(&activity, iterations, kEventsPerBurst);
+    int64_t inputWakeups =
+            __atomic_load_n(&g_wakeups, __ATOMIC_RELAXED) - wakeupsBefore;
+
+    // Read the glue's own counters before tearing the app down; they
+    // are only collected when the glue is built with
+    // -DNDK_GLUE_ENABLE_TRACING, as this harness is.
+    struct android_app_stats stats = app->stats;
+
+    StampCmd(APP_CMD_TERM_WINDOW);
+    callbacks.onNativeWindowDestroyed(&activity, window);
+    StampCmd(APP_CMD_DESTROY);
+    callbacks.onDestroy(&activity);
+
+    printf("iterations: %d\n\n", iterations);
+    ReportLatencies();
+
+    printf("\n%-38s %12" PRId64 "\n", "lifecycle wakeups (4 cmds/iter):",
+           lifecycleWakeups);
+    printf("%-38s %12" PRId64 "\n", "rotation wakeups (3 cmds/iter):",
+           rotationWakeups);
+    printf("%-38s %12" PRId64 "\n", "input wakeups:", inputWakeups);
+    printf("%-38s %12" PRId64 "\n", "input events handled:",
+           g_inputEventsHandled);
+    printf("%-38s %12" PRId64 " / %" PRId64 "\n",
+           "configDiff checks ok/mismatched:", g_configDiffOk,
+           g_configDiffMismatches);
+    printf("\nglue stats:\n");
+    printf("%-38s %12" PRIu64 "\n", "cmdsProcessed:", stats.cmdsProcessed);
+    printf("%-38s %12" PRIu64 "\n", "cmdsCoalesced:", stats.cmdsCoalesced);
+    printf("%-38s %12.1f\n", "cmd latency mean (us):",
+           stats.cmdsProcessed ? stats.cmdLatencyTotalNs / 1e3 / stats.cmdsProcessed
+                               : 0.0);
+    printf("%-38s %12.1f\n", "cmd latency max (us):",
+           stats.cmdLatencyMaxNs / 1e3);
+    printf("%-38s %12" PRIu64 "\n", "inputEventsProcessed:",
+           stats.inputEventsProcessed);
+    printf("%-38s %12" PRIu64 "\n", "inputWakeups:", stats.inputWakeups);
+    printf("%-38s %12" PRIu64 "\n", "maxEventsPerWakeup:",
+           stats.maxEventsPerWakeup);
+    return 0;
+}
@@ -0,0 +1,494 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Functional host implementations of the NDK pieces the glue consumes.
+ * These are not stubs that return constants: the looper really polls,
+ * the input queue really signals through an eventfd, so the glue's
+ * wakeup and batching behavior on the host matches the device within
+ * the fidelity of the scheduler.
+ */
+
+#include "host_shim.h"
+
+#include <pthread.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <android/configuration.h>
+#include <android/input.h>
+#include <android/log.h>
+#include <android/looper.h>
+
+// --------------------------------------------------------------------
+// Logging
+// --------------------------------------------------------------------
+
+static int g_logPriority = ANDROID_LOG_WARN;
+
+void host_log_set_priority(int prio) {
+    g_logPriority = prio;
+}
+
+int __android_log_print(int prio, const char* tag, const char* fmt, ...) {
+    static const char kPrioChar[] = "??VDIWEFS";
+    va_list ap;
+
+    if (prio < g_logPriority) {
+        return 0;
+    }
+
+    flockfile(stderr);
+    fprintf(stderr, "%c/%s: ",
+            (prio >= 0 && prio < (int)sizeof(kPrioChar) - 1) ? kPrioChar[prio] : '?',
+            tag);
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+    funlockfile(stderr);
+    return 1;
+}
+
+// --------------------------------------------------------------------
+// ALooper: one looper per thread over poll(2)
+// --------------------------------------------------------------------
+
+#define HOST_LOOPER_MAX_FDS 32
+
+struct ALooperFd {
+    int fd;
+    int ident;
+    int events;
+    ALooper_callbackFunc callback;
+    void* data;
+};
+
+struct ALooper {
+    struct ALooperFd fds[HOST_LOOPER_MAX_FDS];
+    int fdCount;
+    int wakeFd;
+};
+
+static __thread ALooper* t_looper;
+
+ALooper* ALooper_prepare(int opts) {
+    (void)opts;
+    if (t_looper == NULL) {
+        ALooper* looper = calloc(1, sizeof(*looper));
+        looper->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        t_looper = looper;
+    }
+    return t_looper;
+}
+
+ALooper* ALooper_forThread(void) {
+    return t_looper;
+}
+
+int ALooper_addFd(ALooper* looper, int fd, int ident, int events,
+                  ALooper_callbackFunc callback, void* data) {
+    int n;
+    for (n = 0; n < looper->fdCount; n++) {
+        if (looper->fds[n].fd == fd) {
+            break;
+        }
+    }
+    if (n == looper->fdCount) {
+        if (looper->fdCount == HOST_LOOPER_MAX_FDS) {
+            return -1;
+        }
+        looper->fdCount++;
+    }
+    looper->fds[n].fd = fd;
+    looper->fds[n].ident = ident;
+    looper->fds[n].events = events;
+    looper->fds[n].callback = callback;
+    looper->fds[n].data = data;
+    return 1;
+}
+
+int ALooper_removeFd(ALooper* looper, int fd) {
+    int n;
+    for (n = 0; n < looper->fdCount; n++) {
+        if (looper->fds[n].fd == fd) {
+            memmove(&looper->fds[n], &looper->fds[n + 1],
+                    (looper->fdCount - n - 1) * sizeof(looper->fds[0]));
+            looper->fdCount--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int ALooper_pollOnce(int timeoutMillis, int* outFd, int* outEvents, void** outData) {
+    ALooper* looper = t_looper;
+    struct pollfd pfds[HOST_LOOPER_MAX_FDS + 1];
+    int n, ready, dispatched = 0;
+
+    if (looper == NULL) {
+        return ALOOPER_POLL_ERROR;
+    }
+
+    pfds[0].fd = looper->wakeFd;
+    pfds[0].events = POLLIN;
+    pfds[0].revents = 0;
+    for (n = 0; n < looper->fdCount; n++) {
+        pfds[n + 1].fd = looper->fds[n].fd;
+        pfds[n + 1].events = POLLIN;
+        pfds[n + 1].revents = 0;
+    }
+
+    ready = poll(pfds, looper->fdCount + 1, timeoutMillis);
+    if (ready < 0) {
+        return ALOOPER_POLL_ERROR;
+    }
+    if (ready == 0) {
+        return ALOOPER_POLL_TIMEOUT;
+    }
+
+    if (pfds[0].revents & POLLIN) {
+        uint64_t counter;
+        if (read(looper->wakeFd, &counter, sizeof(counter)) < 0) {
+            /* Nonblocking; a racing wake is fine. */
+        }
+        return ALOOPER_POLL_WAKE;
+    }
+
+    /* Dispatch every ready callback fd, then report the first ready
+     * ident fd, matching the real looper's behavior closely enough for
+     * the glue (which registers ident fds only).
+     */
+    for (n = 0; n < looper->fdCount; n++) {
+        if ((pfds[n + 1].revents & POLLIN) == 0) {
+            continue;
+        }
+        if (looper->fds[n].callback != NULL) {
+            if (looper->fds[n].callback(looper->fds[n].fd, ALOOPER_EVENT_INPUT,
+                                        looper->fds[n].data) == 0) {
+                ALooper_removeFd(looper, looper->fds[n].fd);
+                n--;
+            }
+            dispatched = 1;
+            continue;
+        }
+        if (outFd != NULL) *outFd = looper->fds[n].fd;
+        if (outEvents != NULL) *outEvents = ALOOPER_EVENT_INPUT;
+        if (outData != NULL) *outData = looper->fds[n].data;
+        return looper->fds[n].ident;
+    }
+
+    return dispatched ? ALOOPER_POLL_CALLBACK : ALOOPER_POLL_TIMEOUT;
+}
+
+int ALooper_pollAll(int timeoutMillis, int* outFd, int* outEvents, void** outData) {
+    int result;
+    do {
+        result = ALooper_pollOnce(timeoutMillis, outFd, outEvents, outData);
+    } while (result == ALOOPER_POLL_CALLBACK);
+    return result;
+}
+
+void ALooper_wake(ALooper* looper) {
+    uint64_t one = 1;
+    if (write(looper->wakeFd, &one, sizeof(one)) < 0) {
+        /* Counter saturated; the wakeup is already pending. */
+    }
+}
+
+// --------------------------------------------------------------------
+// AInputQueue: synthetic eventfd-signaled queue
+// --------------------------------------------------------------------
+
+#define HOST_INPUT_QUEUE_CAPACITY 1024
+
+struct AInputEvent {
+    int32_t type;
+    int32_t source;
+    int32_t action;
+    int32_t keyCode;
+    int32_t metaState;
+    int64_t eventTimeNs;
+    size_t pointerCount;
+    int32_t pointerId;
+    float x, y, pressure;
+};
+
+struct AInputQueue {
+    pthread_mutex_t lock;
+    struct AInputEvent events[HOST_INPUT_QUEUE_CAPACITY];
+    /* readPos chases writePos; a slot stays live (its pointer may be
+     * held by the consumer) until finishEvent, so the producer treats
+     * writePos - finished as the occupancy.
+     */
+    uint32_t readPos;
+    uint32_t writePos;
+    uint32_t finished;
+    int efd;
+    ALooper* looper;
+};
+
+static int64_t host_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000ll + ts.tv_nsec;
+}
+
+AInputQueue* host_input_queue_create(void) {
+    AInputQueue* queue = calloc(1, sizeof(*queue));
+    pthread_mutex_init(&queue->lock, NULL);
+    queue->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return queue;
+}
+
+void host_input_queue_destroy(AInputQueue* queue) {
+    close(queue->efd);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue);
+}
+
+static int host_input_queue_push(AInputQueue* queue,
+                                 const struct AInputEvent* event) {
+    uint64_t one = 1;
+
+    pthread_mutex_lock(&queue->lock);
+    if (queue->writePos - queue->finished >= HOST_INPUT_QUEUE_CAPACITY) {
+        pthread_mutex_unlock(&queue->lock);
+        return 0;
+    }
+    queue->events[queue->writePos % HOST_INPUT_QUEUE_CAPACITY] = *event;
+    queue->writePos++;
+    pthread_mutex_unlock(&queue->lock);
+
+    if (write(queue->efd, &one, sizeof(one)) < 0) {
+        /* Counter saturated; a wakeup is already pending. */
+    }
+    return 1;
+}
+
+int host_input_queue_push_key(AInputQueue* queue, int32_t action, int32_t keyCode) {
+    struct AInputEvent event;
+    memset(&event, 0, sizeof(event));
+    event.type = AINPUT_EVENT_TYPE_KEY;
+    event.action = action;
+    event.keyCode = keyCode;
+    event.eventTimeNs = host_now_ns();
+    return host_input_queue_push(queue, &event);
+}
+
+int host_input_queue_push_motion(AInputQueue* queue, int32_t action, float x, float y) {
+    struct AInputEvent event;
+    memset(&event, 0, sizeof(event));
+    event.type = AINPUT_EVENT_TYPE_MOTION;
+    event.action = action;
+    event.eventTimeNs = host_now_ns();
+    event.pointerCount = 1;
+    event.x = x;
+    event.y = y;
+    event.pressure = 1.0f;
+    return host_input_queue_push(queue, &event);
+}
+
+int host_input_queue_outstanding(AInputQueue* queue) {
+    int outstanding;
+    pthread_mutex_lock(&queue->lock);
+    outstanding = (int)(queue->writePos - queue->finished);
+    pthread_mutex_unlock(&queue->lock);
+    return outstanding;
+}
+
+int32_t AInputQueue_getEvent(AInputQueue* queue, AInputEvent** outEvent) {
+    pthread_mutex_lock(&queue->lock);
+    if (queue->readPos == queue->writePos) {
+        uint64_t counter;
+        pthread_mutex_unlock(&queue->lock);
+        /* Queue drained: consume the looper wakeup, then recheck for
+         * events pushed since (the producer signals after publishing).
+         */
+        if (read(queue->efd, &counter, sizeof(counter)) < 0) {
+            /* Nonblocking; nothing pending. */
+        }
+        pthread_mutex_lock(&queue->lock);
+        if (queue->readPos == queue->writePos) {
+            pthread_mutex_unlock(&queue->lock);
+            return -1;
+        }
+    }
+    *outEvent = &queue->events[queue->readPos % HOST_INPUT_QUEUE_CAPACITY];
+    queue->readPos++;
+    pthread_mutex_unlock(&queue->lock);
+    return 0;
+}
+
+int32_t AInputQueue_preDispatchEvent(AInputQueue* queue, AInputEvent* event) {
+    (void)queue;
+    (void)event;
+    return 0;
+}
+
+void AInputQueue_finishEvent(AInputQueue* queue, AInputEvent* event, int handled) {
+    (void)event;
+    (void)handled;
+    pthread_mutex_lock(&queue->lock);
+    queue->finished++;
+    pthread_mutex_unlock(&queue->lock);
+}
+
+void AInputQueue_attachLooper(AInputQueue* queue, ALooper* looper, int ident,
+                              ALooper_callbackFunc callback, void* data) {
+    queue->looper = looper;
+    ALooper_addFd(looper, queue->efd, ident, ALOOPER_EVENT_INPUT, callback, data);
+}
+
+void AInputQueue_detachLooper(AInputQueue* queue) {
+    if (queue->looper != NULL) {
+        ALooper_removeFd(queue->looper, queue->efd);
+        queue->looper = NULL;
+    }
+}
+
+int32_t AInputEvent_getType(const AInputEvent* event) { return event->type; }
+int32_t AInputEvent_getSource(const AInputEvent* event) { return event->source; }
+
+int32_t AKeyEvent_getAction(const AInputEvent* e) { return e->action; }
+int32_t AKeyEvent_getKeyCode(const AInputEvent* e) { return e->keyCode; }
+int32_t AKeyEvent_getMetaState(const AInputEvent* e) { return e->metaState; }
+int64_t AKeyEvent_getEventTime(const AInputEvent* e) { return e->eventTimeNs; }
+
+int32_t AMotionEvent_getAction(const AInputEvent* e) { return e->action; }
+int32_t AMotionEvent_getMetaState(const AInputEvent* e) { return e->metaState; }
+int64_t AMotionEvent_getEventTime(const AInputEvent* e) { return e->eventTimeNs; }
+size_t AMotionEvent_getPointerCount(const AInputEvent* e) { return e->pointerCount; }
+int32_t AMotionEvent_getPointerId(const AInputEvent* e, size_t i) {
+    (void)i;
+    return e->pointerId;
+}
+float AMotionEvent_getX(const AInputEvent* e, size_t i) { (void)i; return e->x; }
+float AMotionEvent_getY(const AInputEvent* e, size_t i) { (void)i; return e->y; }
+float AMotionEvent_getPressure(const AInputEvent* e, size_t i) {
+    (void)i;
+    return e->pressure;
+}
+
+// --------------------------------------------------------------------
+// AConfiguration
+// --------------------------------------------------------------------
+
+struct AConfiguration {
+    int32_t mcc, mnc;
+    char language[2], country[2];
+    int32_t orientation, touchscreen, density, keyboard, navigation;
+    int32_t keysHidden, navHidden, sdkVersion, screenSize, screenLong;
+    int32_t uiModeType, uiModeNight;
+};
+
+/* The simulated device configuration that AConfiguration_fromAssetManager
+ * snapshots, standing in for the framework resources. The harness
+ * mutates it (via host_device_configuration()) before raising
+ * onConfigurationChanged, exactly as a real rotation would.
+ */
+static struct AConfiguration g_deviceConfig = {
+    .language = { 'e', 'n' },
+    .country = { 'U', 'S' },
+    .orientation = ACONFIGURATION_ORIENTATION_PORT,
+    .density = 160,
+    .sdkVersion = 24,
+};
+
+AConfiguration* host_device_configuration(void) {
+    return &g_deviceConfig;
+}
+
+AConfiguration* AConfiguration_new(void) {
+    return calloc(1, sizeof(AConfiguration));
+}
+
+void AConfiguration_delete(AConfiguration* config) {
+    free(config);
+}
+
+void AConfiguration_fromAssetManager(AConfiguration* out, struct AAssetManager* am) {
+    (void)am;
+    *out = g_deviceConfig;
+}
+
+void AConfiguration_copy(AConfiguration* dest, AConfiguration* src) {
+    *dest = *src;
+}
+
+int32_t AConfiguration_diff(AConfiguration* config1, AConfiguration* config2) {
+    int32_t diff = 0;
+    if (config1->mcc != config2->mcc) diff |= ACONFIGURATION_MCC;
+    if (config1->mnc != config2->mnc) diff |= ACONFIGURATION_MNC;
+    if (memcmp(config1->language, config2->language, 2) != 0 ||
+        memcmp(config1->country, config2->country, 2) != 0) {
+        diff |= ACONFIGURATION_LOCALE;
+    }
+    if (config1->touchscreen != config2->touchscreen) diff |= ACONFIGURATION_TOUCHSCREEN;
+    if (config1->keyboard != config2->keyboard) diff |= ACONFIGURATION_KEYBOARD;
+    if (config1->keysHidden != config2->keysHidden ||
+        config1->navHidden != config2->navHidden) {
+        diff |= ACONFIGURATION_KEYBOARD_HIDDEN;
+    }
+    if (config1->navigation != config2->navigation) diff |= ACONFIGURATION_NAVIGATION;
+    if (config1->orientation != config2->orientation) diff |= ACONFIGURATION_ORIENTATION;
+    if (config1->density != config2->density) diff |= ACONFIGURATION_DENSITY;
+    if (config1->screenSize != config2->screenSize) diff |= ACONFIGURATION_SCREEN_SIZE;
+    if (config1->screenLong != config2->screenLong) diff |= ACONFIGURATION_SCREEN_LAYOUT;
+    if (config1->sdkVersion != config2->sdkVersion) diff |= ACONFIGURATION_VERSION;
+    if (config1->uiModeType != config2->uiModeType ||
+        config1->uiModeNight != config2->uiModeNight) {
+        diff |= ACONFIGURATION_UI_MODE;
+    }
+    return diff;
+}
+
+int32_t AConfiguration_getMcc(AConfiguration* c) { return c->mcc; }
+int32_t AConfiguration_getMnc(AConfiguration* c) { return c->mnc; }
+void AConfiguration_getLanguage(AConfiguration* c, char* out) {
+    memcpy(out, c->language, 2);
+}
+void AConfiguration_getCountry(AConfiguration* c, char* out) {
+    memcpy(out, c->country, 2);
+}
+int32_t AConfiguration_getOrientation(AConfiguration* c) { return c->orientation; }
+int32_t AConfiguration_getTouchscreen(AConfiguration* c) { return c->touchscreen; }
+int32_t AConfiguration_getDensity(AConfiguration* c) { return c->density; }
+int32_t AConfiguration_getKeyboard(AConfiguration* c) { return c->keyboard; }
+int32_t AConfiguration_getNavigation(AConfiguration* c) { return c->navigation; }
+int32_t AConfiguration_getKeysHidden(AConfiguration* c) { return c->keysHidden; }
+int32_t AConfiguration_getNavHidden(AConfiguration* c) { return c->navHidden; }
+int32_t AConfiguration_getSdkVersion(AConfiguration* c) { return c->sdkVersion; }
+int32_t AConfiguration_getScreenSize(AConfiguration* c) { return c->screenSize; }
+int32_t AConfiguration_getScreenLong(AConfiguration* c) { return c->screenLong; }
+int32_t AConfiguration_getUiModeType(AConfiguration* c) { return c->uiModeType; }
+int32_t AConfiguration_getUiModeNight(AConfiguration* c) { return c->uiModeNight; }
+
+void AConfiguration_setMcc(AConfiguration* c, int32_t mcc) { c->mcc = mcc; }
+void AConfiguration_setOrientation(AConfiguration* c, int32_t orientation) {
+    c->orientation = orientation;
+}
+void AConfiguration_setDensity(AConfiguration* c, int32_t density) {
+    c->density = density;
+}
+void AConfiguration_setKeyboard(AConfiguration* c, int32_t keyboard) {
+    c->keyboard = keyboard;
+}
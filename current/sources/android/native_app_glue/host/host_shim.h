@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Harness-side control interface for the host shims. The shims in
+ * host_shim.c implement the NDK surface the glue consumes (see the
+ * headers under include/android); this header adds the producer side
+ * the real framework would play: fabricating input events and steering
+ * the shim configuration.
+ */
+
+#ifndef _NATIVE_APP_GLUE_HOST_SHIM_H
+#define _NATIVE_APP_GLUE_HOST_SHIM_H
+
+#include <stdint.h>
+
+#include <android/configuration.h>
+#include <android/input.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Create/destroy a synthetic input queue. The queue is signaled through
+ * an eventfd, so attaching it to the glue's looper behaves like the
+ * real thing: one wakeup per burst, drained by AInputQueue_getEvent().
+ */
+AInputQueue* host_input_queue_create(void);
+void host_input_queue_destroy(AInputQueue* queue);
+
+/* Push one fabricated event. Returns 1 on success and 0 when the queue
+ * is full (the harness is outrunning the consumer by more than the
+ * queue capacity).
+ */
+int host_input_queue_push_key(AInputQueue* queue, int32_t action, int32_t keyCode);
+int host_input_queue_push_motion(AInputQueue* queue, int32_t action, float x, float y);
+
+/* Number of pushed events not yet finished by the consumer. The
+ * harness polls this to know when a flood has fully drained.
+ */
+int host_input_queue_outstanding(AInputQueue* queue);
+
+/* The simulated device configuration snapshotted by
+ * AConfiguration_fromAssetManager(). Mutate it (AConfiguration_setXxx)
+ * before raising onConfigurationChanged to simulate a rotation or
+ * density change.
+ */
+AConfiguration* host_device_configuration(void);
+
+/* Suppress shim log output below the given priority
+ * (ANDROID_LOG_SILENT mutes everything). Defaults to ANDROID_LOG_WARN
+ * so soak runs are not dominated by the glue's verbose traces.
+ */
+void host_log_set_priority(int prio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _NATIVE_APP_GLUE_HOST_SHIM_H */
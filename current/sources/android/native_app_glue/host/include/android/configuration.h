@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host shim for <android/configuration.h>. AConfiguration is a plain
+ * struct of the fields the glue queries; the setters let the harness
+ * stand in for the framework when simulating configuration changes.
+ * Implemented in host_shim.c.
+ */
+
+#ifndef _NATIVE_APP_GLUE_HOST_ANDROID_CONFIGURATION_H
+#define _NATIVE_APP_GLUE_HOST_ANDROID_CONFIGURATION_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct AAssetManager;
+typedef struct AConfiguration AConfiguration;
+
+enum {
+    ACONFIGURATION_ORIENTATION_ANY = 0x0000,
+    ACONFIGURATION_ORIENTATION_PORT = 0x0001,
+    ACONFIGURATION_ORIENTATION_LAND = 0x0002,
+};
+
+AConfiguration* AConfiguration_new(void);
+void AConfiguration_delete(AConfiguration* config);
+void AConfiguration_fromAssetManager(AConfiguration* out, struct AAssetManager* am);
+void AConfiguration_copy(AConfiguration* dest, AConfiguration* src);
+
+/* Returns a bitmask of ACONFIGURATION_* bits for the fields that differ
+ * between the two configurations, as in the real NDK.
+ */
+int32_t AConfiguration_diff(AConfiguration* config1, AConfiguration* config2);
+
+enum {
+    ACONFIGURATION_MCC = 0x0001,
+    ACONFIGURATION_MNC = 0x0002,
+    ACONFIGURATION_LOCALE = 0x0004,
+    ACONFIGURATION_TOUCHSCREEN = 0x0008,
+    ACONFIGURATION_KEYBOARD = 0x0010,
+    ACONFIGURATION_KEYBOARD_HIDDEN = 0x0020,
+    ACONFIGURATION_NAVIGATION = 0x0040,
+    ACONFIGURATION_ORIENTATION = 0x0080,
+    ACONFIGURATION_DENSITY = 0x0100,
+    ACONFIGURATION_SCREEN_SIZE = 0x0200,
+    ACONFIGURATION_VERSION = 0x0400,
+    ACONFIGURATION_SCREEN_LAYOUT = 0x0800,
+    ACONFIGURATION_UI_MODE = 0x1000,
+};
+
+int32_t AConfiguration_getMcc(AConfiguration* config);
+int32_t AConfiguration_getMnc(AConfiguration* config);
+void AConfiguration_getLanguage(AConfiguration* config, char* outLanguage);
+void AConfiguration_getCountry(AConfiguration* config, char* outCountry);
+int32_t AConfiguration_getOrientation(AConfiguration* config);
+int32_t AConfiguration_getTouchscreen(AConfiguration* config);
+int32_t AConfiguration_getDensity(AConfiguration* config);
+int32_t AConfiguration_getKeyboard(AConfiguration* config);
+int32_t AConfiguration_getNavigation(AConfiguration* config);
+int32_t AConfiguration_getKeysHidden(AConfiguration* config);
+int32_t AConfiguration_getNavHidden(AConfiguration* config);
+int32_t AConfiguration_getSdkVersion(AConfiguration* config);
+int32_t AConfiguration_getScreenSize(AConfiguration* config);
+int32_t AConfiguration_getScreenLong(AConfiguration* config);
+int32_t AConfiguration_getUiModeType(AConfiguration* config);
+int32_t AConfiguration_getUiModeNight(AConfiguration* config);
+
+void AConfiguration_setMcc(AConfiguration* config, int32_t mcc);
+void AConfiguration_setOrientation(AConfiguration* config, int32_t orientation);
+void AConfiguration_setDensity(AConfiguration* config, int32_t density);
+void AConfiguration_setKeyboard(AConfiguration* config, int32_t keyboard);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _NATIVE_APP_GLUE_HOST_ANDROID_CONFIGURATION_H */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host shim for <android/input.h>. AInputQueue is a synthetic,
+ * eventfd-signaled queue that the soak harness fills with fabricated
+ * events through the helpers in host_shim.h; the accessor functions
+ * read back what the harness pushed. Implemented in host_shim.c.
+ */
+
+#ifndef _NATIVE_APP_GLUE_HOST_ANDROID_INPUT_H
+#define _NATIVE_APP_GLUE_HOST_ANDROID_INPUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <android/looper.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct AInputEvent AInputEvent;
+typedef struct AInputQueue AInputQueue;
+
+enum {
+    AINPUT_EVENT_TYPE_KEY = 1,
+    AINPUT_EVENT_TYPE_MOTION = 2,
+};
+
+enum {
+    AKEY_EVENT_ACTION_DOWN = 0,
+    AKEY_EVENT_ACTION_UP = 1,
+};
+
+enum {
+    AMOTION_EVENT_ACTION_DOWN = 0,
+    AMOTION_EVENT_ACTION_UP = 1,
+    AMOTION_EVENT_ACTION_MOVE = 2,
+};
+
+int32_t AInputEvent_getType(const AInputEvent* event);
+int32_t AInputEvent_getSource(const AInputEvent* event);
+
+int32_t AKeyEvent_getAction(const AInputEvent* key_event);
+int32_t AKeyEvent_getKeyCode(const AInputEvent* key_event);
+int32_t AKeyEvent_getMetaState(const AInputEvent* key_event);
+int64_t AKeyEvent_getEventTime(const AInputEvent* key_event);
+
+int32_t AMotionEvent_getAction(const AInputEvent* motion_event);
+int32_t AMotionEvent_getMetaState(const AInputEvent* motion_event);
+int64_t AMotionEvent_getEventTime(const AInputEvent* motion_event);
+size_t AMotionEvent_getPointerCount(const AInputEvent* motion_event);
+int32_t AMotionEvent_getPointerId(const AInputEvent* motion_event, size_t pointer_index);
+float AMotionEvent_getX(const AInputEvent* motion_event, size_t pointer_index);
+float AMotionEvent_getY(const AInputEvent* motion_event, size_t pointer_index);
+float AMotionEvent_getPressure(const AInputEvent* motion_event, size_t pointer_index);
+
+int32_t AInputQueue_getEvent(AInputQueue* queue, AInputEvent** outEvent);
+int32_t AInputQueue_preDispatchEvent(AInputQueue* queue, AInputEvent* event);
+void AInputQueue_finishEvent(AInputQueue* queue, AInputEvent* event, int handled);
+void AInputQueue_attachLooper(AInputQueue* queue, ALooper* looper, int ident,
+                              ALooper_callbackFunc callback, void* data);
+void AInputQueue_detachLooper(AInputQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _NATIVE_APP_GLUE_HOST_ANDROID_INPUT_H */
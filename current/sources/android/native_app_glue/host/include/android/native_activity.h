@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host shim for <android/native_activity.h>. Mirrors the real struct
+ * layout closely enough for the glue; the soak harness fills in a fake
+ * ANativeActivity and drives the callbacks table the way the framework
+ * would.
+ */
+
+#ifndef _NATIVE_APP_GLUE_HOST_ANDROID_NATIVE_ACTIVITY_H
+#define _NATIVE_APP_GLUE_HOST_ANDROID_NATIVE_ACTIVITY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <jni.h>
+
+#include <android/input.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ARect {
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+} ARect;
+
+/* Never dereferenced by the glue; the harness passes an opaque token. */
+typedef struct ANativeWindow ANativeWindow;
+
+struct AAssetManager;
+struct ANativeActivityCallbacks;
+
+typedef struct ANativeActivity {
+    struct ANativeActivityCallbacks* callbacks;
+    JavaVM* vm;
+    JNIEnv* env;
+    void* clazz;
+    const char* internalDataPath;
+    const char* externalDataPath;
+    int32_t sdkVersion;
+    void* instance;
+    struct AAssetManager* assetManager;
+    const char* obbPath;
+} ANativeActivity;
+
+typedef struct ANativeActivityCallbacks {
+    void (*onStart)(ANativeActivity* activity);
+    void (*onResume)(ANativeActivity* activity);
+    void* (*onSaveInstanceState)(ANativeActivity* activity, size_t* outSize);
+    void (*onPause)(ANativeActivity* activity);
+    void (*onStop)(ANativeActivity* activity);
+    void (*onDestroy)(ANativeActivity* activity);
+    void (*onWindowFocusChanged)(ANativeActivity* activity, int hasFocus);
+    void (*onNativeWindowCreated)(ANativeActivity* activity, ANativeWindow* window);
+    void (*onNativeWindowResized)(ANativeActivity* activity, ANativeWindow* window);
+    void (*onNativeWindowRedrawNeeded)(ANativeActivity* activity, ANativeWindow* window);
+    void (*onNativeWindowDestroyed)(ANativeActivity* activity, ANativeWindow* window);
+    void (*onInputQueueCreated)(ANativeActivity* activity, AInputQueue* queue);
+    void (*onInputQueueDestroyed)(ANativeActivity* activity, AInputQueue* queue);
+    void (*onContentRectChanged)(ANativeActivity* activity, const ARect* rect);
+    void (*onConfigurationChanged)(ANativeActivity* activity);
+    void (*onLowMemory)(ANativeActivity* activity);
+} ANativeActivityCallbacks;
+
+/* Defined by android_native_app_glue.c; the harness calls it directly,
+ * playing the part of the NativeActivity framework.
+ */
+JNIEXPORT
+void ANativeActivity_onCreate(ANativeActivity* activity, void* savedState,
+                              size_t savedStateSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _NATIVE_APP_GLUE_HOST_ANDROID_NATIVE_ACTIVITY_H */
@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host shim for <jni.h>. The glue stores the VM/env pointers but never
+ * calls through them, so opaque types are all that is needed.
+ */
+
+#ifndef _NATIVE_APP_GLUE_HOST_JNI_H
+#define _NATIVE_APP_GLUE_HOST_JNI_H
+
+typedef struct _JavaVM JavaVM;
+typedef struct _JNIEnv JNIEnv;
+
+#define JNIEXPORT __attribute__((visibility("default")))
+
+#endif  /* _NATIVE_APP_GLUE_HOST_JNI_H */
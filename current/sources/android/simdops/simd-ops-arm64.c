@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/* AArch64 kernels. This file is built with -march=armv8-a+crc+crypto;
+ * only the ASIMD memcpy may be called unconditionally (ASIMD is
+ * architecturally mandatory), the CRC32 and AES kernels require the
+ * matching feature bits, verified by the dispatch core.
+ */
+
+#ifdef __aarch64__
+
+#include "simd-ops-internal.h"
+
+#include <string.h>
+
+#include <arm_acle.h>
+#include <arm_neon.h>
+
+void* android_simd_memcpy_asimd(void* dst, const void* src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    /* 64-byte transfers keep the write-combine buffers of uncached
+     * (streaming) destinations full, which is where this beats a
+     * cacheline-clever general-purpose memcpy.
+     */
+    while (n >= 64) {
+        uint8x16x4_t q = vld1q_u8_x4(s);
+        vst1q_u8_x4(d, q);
+        s += 64;
+        d += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        vst1q_u8(d, vld1q_u8(s));
+        s += 16;
+        d += 16;
+        n -= 16;
+    }
+    if (n > 0) {
+        memcpy(d, s, n);
+    }
+    return dst;
+}
+
+uint32_t android_simd_crc32c_arm64(uint32_t crc, const void* buf, size_t n) {
+    const uint8_t* p = (const uint8_t*)buf;
+
+    crc = ~crc;
+    while (n >= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+        p += 8;
+        n -= 8;
+    }
+    while (n-- > 0) {
+        crc = __crc32cb(crc, *p++);
+    }
+    return ~crc;
+}
+
+/* FIPS-197 key expansion on the AES unit. ARMv8 has no dedicated
+ * key-schedule instruction, but AESE with an all-zero round key reduces
+ * to ShiftRows(SubBytes(x)), and on a vector holding the same word in
+ * all four lanes ShiftRows is a no-op -- leaving exactly SubWord. The
+ * key therefore never touches a software S-box, so expanding on every
+ * call leaks nothing through the cache.
+ */
+static void aes128_expand_key(const uint8_t key[16], uint8x16_t k[11]) {
+    static const uint8_t kRcon[10] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36,
+    };
+    uint32_t w[4];
+
+    memcpy(w, key, 16);
+    k[0] = vld1q_u8(key);
+    for (int round = 1; round <= 10; round++) {
+        uint8x16_t sub = vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(w[3])),
+                                   vdupq_n_u8(0));
+        uint32_t t = vgetq_lane_u32(vreinterpretq_u32_u8(sub), 0);
+        t = (t >> 8) | (t << 24);  /* RotWord */
+        w[0] ^= t ^ kRcon[round - 1];
+        w[1] ^= w[0];
+        w[2] ^= w[1];
+        w[3] ^= w[2];
+        k[round] = vreinterpretq_u8_u32(vld1q_u32(w));
+    }
+}
+
+void android_simd_aes128_ecb_arm64(const uint8_t key[16],
+                                   uint8_t* out, const uint8_t* in,
+                                   size_t nblocks) {
+    uint8x16_t k[11];
+    aes128_expand_key(key, k);
+
+    while (nblocks-- > 0) {
+        uint8x16_t b = vld1q_u8(in);
+        /* AESE folds the AddRoundKey of the *previous* round, so the
+         * round structure differs from the AES-NI one: nine
+         * AESE+AESMC pairs, a final AESE, then the last round key.
+         */
+        for (int r = 0; r < 9; r++) {
+            b = vaesmcq_u8(vaeseq_u8(b, k[r]));
+        }
+        b = vaeseq_u8(b, k[9]);
+        b = veorq_u8(b, k[10]);
+        vst1q_u8(out, b);
+        in += 16;
+        out += 16;
+    }
+}
+
+#endif  /* __aarch64__ */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/* Kernel prototypes shared between the dispatch core (simd-ops.c) and
+ * the per-ISA translation units, which are the only files built with
+ * raised -march/-mfpu flags. Nothing here is public API.
+ */
+
+#ifndef SIMD_OPS_INTERNAL_H
+#define SIMD_OPS_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __arm__
+void* android_simd_memcpy_neon(void* dst, const void* src, size_t n);
+#endif
+
+#ifdef __aarch64__
+void* android_simd_memcpy_asimd(void* dst, const void* src, size_t n);
+uint32_t android_simd_crc32c_arm64(uint32_t crc, const void* buf, size_t n);
+/* Takes the raw cipher key: the kernels run the FIPS-197 key schedule
+ * themselves on the AES hardware, so no key byte ever indexes a
+ * software table.
+ */
+void android_simd_aes128_ecb_arm64(const uint8_t key[16],
+                                   uint8_t* out, const uint8_t* in,
+                                   size_t nblocks);
+#endif
+
+#if defined(__i386__) || defined(__x86_64__)
+uint32_t android_simd_crc32c_sse42(uint32_t crc, const void* buf, size_t n);
+void android_simd_aes128_ecb_aesni(const uint8_t key[16],
+                                   uint8_t* out, const uint8_t* in,
+                                   size_t nblocks);
+#endif
+
+#endif  /* SIMD_OPS_INTERNAL_H */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/* 32-bit ARM NEON kernels. This file is built with -mfpu=neon; the
+ * dispatch core only selects these when
+ * ANDROID_CPU_ARM_FEATURE_NEON is set, so plain VFP devices stay on
+ * the fallbacks.
+ */
+
+#ifdef __arm__
+
+#include "simd-ops-internal.h"
+
+#include <string.h>
+
+#include <arm_neon.h>
+
+void* android_simd_memcpy_neon(void* dst, const void* src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    /* 64 bytes per iteration: wide stores keep write-combine buffers
+     * full on uncached (streaming) destinations.
+     */
+    while (n >= 64) {
+        uint8x16_t q0 = vld1q_u8(s);
+        uint8x16_t q1 = vld1q_u8(s + 16);
+        uint8x16_t q2 = vld1q_u8(s + 32);
+        uint8x16_t q3 = vld1q_u8(s + 48);
+        vst1q_u8(d, q0);
+        vst1q_u8(d + 16, q1);
+        vst1q_u8(d + 32, q2);
+        vst1q_u8(d + 48, q3);
+        s += 64;
+        d += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        vst1q_u8(d, vld1q_u8(s));
+        s += 16;
+        d += 16;
+        n -= 16;
+    }
+    if (n > 0) {
+        memcpy(d, s, n);
+    }
+    return dst;
+}
+
+#endif  /* __arm__ */
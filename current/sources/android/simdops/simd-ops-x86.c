@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/* x86/x86_64 kernels. This file is built with -msse4.2 -maes; nothing
+ * in it may be called unless the dispatch core verified the matching
+ * feature bits.
+ */
+
+#if defined(__i386__) || defined(__x86_64__)
+
+#include "simd-ops-internal.h"
+
+#include <string.h>
+
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+
+uint32_t android_simd_crc32c_sse42(uint32_t crc, const void* buf, size_t n) {
+    const uint8_t* p = (const uint8_t*)buf;
+
+    crc = ~crc;
+#if defined(__x86_64__)
+    {
+        uint64_t crc64 = crc;
+        while (n >= 8) {
+            uint64_t v;
+            memcpy(&v, p, 8);
+            crc64 = _mm_crc32_u64(crc64, v);
+            p += 8;
+            n -= 8;
+        }
+        crc = (uint32_t)crc64;
+    }
+#else
+    while (n >= 4) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        crc = _mm_crc32_u32(crc, v);
+        p += 4;
+        n -= 4;
+    }
+#endif
+    while (n-- > 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return ~crc;
+}
+
+/* One FIPS-197 expansion round. AESKEYGENASSIST computes
+ * SubWord(RotWord(w)) ^ rcon into lane 3; the slli/xor ladder produces
+ * the chained word XORs for the rest of the round key.
+ */
+static inline __m128i aes128_expand_step(__m128i key, __m128i assist) {
+    assist = _mm_shuffle_epi32(assist, _MM_SHUFFLE(3, 3, 3, 3));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+/* The rcon operand must be an immediate, hence the macro. */
+#define AES128_EXPAND_ROUND(k, r, rcon)                          \
+    (k)[r] = aes128_expand_step(                                 \
+            (k)[(r) - 1], _mm_aeskeygenassist_si128((k)[(r) - 1], (rcon)))
+
+void android_simd_aes128_ecb_aesni(const uint8_t key[16],
+                                   uint8_t* out, const uint8_t* in,
+                                   size_t nblocks) {
+    /* Key schedule on the AES unit: the key never touches a software
+     * S-box, so expanding on every call leaks nothing through the
+     * cache.
+     */
+    __m128i k[11];
+    k[0] = _mm_loadu_si128((const __m128i*)key);
+    AES128_EXPAND_ROUND(k, 1, 0x01);
+    AES128_EXPAND_ROUND(k, 2, 0x02);
+    AES128_EXPAND_ROUND(k, 3, 0x04);
+    AES128_EXPAND_ROUND(k, 4, 0x08);
+    AES128_EXPAND_ROUND(k, 5, 0x10);
+    AES128_EXPAND_ROUND(k, 6, 0x20);
+    AES128_EXPAND_ROUND(k, 7, 0x40);
+    AES128_EXPAND_ROUND(k, 8, 0x80);
+    AES128_EXPAND_ROUND(k, 9, 0x1b);
+    AES128_EXPAND_ROUND(k, 10, 0x36);
+
+    while (nblocks-- > 0) {
+        __m128i b = _mm_loadu_si128((const __m128i*)in);
+        b = _mm_xor_si128(b, k[0]);
+        for (int r = 1; r < 10; r++) {
+            b = _mm_aesenc_si128(b, k[r]);
+        }
+        b = _mm_aesenclast_si128(b, k[10]);
+        _mm_storeu_si128((__m128i*)out, b);
+        in += 16;
+        out += 16;
+    }
+}
+
+#endif  /* __i386__ || __x86_64__ */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/* Dispatch core for the simdops library. Each entry point owns an
+ * android_cpuResolve() cache, so the first call selects the fastest
+ * eligible kernel from the feature bits and later calls pay one atomic
+ * load. The fallbacks in this file deliberately contain nothing the
+ * compiler could vectorize (table lookups and libc forwards), since
+ * the per-ISA kernels live in separate translation units built with
+ * raised -march/-mfpu flags.
+ */
+
+#include "simd-ops.h"
+#include "simd-ops-internal.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#include <cpu-features.h>
+
+// --------------------------------------------------------------------
+// memcpy
+// --------------------------------------------------------------------
+
+void* android_simd_memcpy(void* dst, const void* src, size_t n) {
+#if defined(__aarch64__)
+    /* ASIMD is architecturally mandatory; no dispatch needed. */
+    return android_simd_memcpy_asimd(dst, src, n);
+#elif defined(__arm__)
+    static const AndroidCpuVariant kVariants[] = {
+        { ANDROID_CPU_ARM_FEATURE_NEON, 0, (void*)android_simd_memcpy_neon },
+    };
+    static void* resolved;
+    typedef void* (*MemcpyFn)(void*, const void*, size_t);
+    return ((MemcpyFn)android_cpuResolve(kVariants, 1, (void*)memcpy,
+                                         &resolved))(dst, src, n);
+#else
+    /* Bionic's x86 memcpy is already vectorized; nothing to add. */
+    return memcpy(dst, src, n);
+#endif
+}
+
+// --------------------------------------------------------------------
+// CRC-32C
+// --------------------------------------------------------------------
+
+/* Table fallback (one 256-entry table, byte at a time). Plenty for the
+ * devices that lack the instructions; the point of the dispatch is
+ * that modern cores never run this.
+ */
+static uint32_t g_crc32c_table[256];
+static pthread_once_t g_crc32c_table_once = PTHREAD_ONCE_INIT;
+
+static void crc32c_table_init(void) {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0x82F63B78U ^ (c >> 1) : c >> 1;
+        }
+        g_crc32c_table[n] = c;
+    }
+}
+
+static uint32_t android_simd_crc32c_table(uint32_t crc, const void* buf,
+                                          size_t n) {
+    const uint8_t* p = (const uint8_t*)buf;
+
+    pthread_once(&g_crc32c_table_once, crc32c_table_init);
+
+    crc = ~crc;
+    while (n-- > 0) {
+        crc = g_crc32c_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t android_simd_crc32c(uint32_t crc, const void* buf, size_t n) {
+    typedef uint32_t (*Crc32cFn)(uint32_t, const void*, size_t);
+#if defined(__aarch64__)
+    static const AndroidCpuVariant kVariants[] = {
+        { ANDROID_CPU_ARM64_FEATURE_CRC32, 0, (void*)android_simd_crc32c_arm64 },
+    };
+    static void* resolved;
+    return ((Crc32cFn)android_cpuResolve(
+            kVariants, 1, (void*)android_simd_crc32c_table,
+            &resolved))(crc, buf, n);
+#elif defined(__i386__) || defined(__x86_64__)
+    static const AndroidCpuVariant kVariants[] = {
+        { ANDROID_CPU_X86_FEATURE_SSE4_2, 0, (void*)android_simd_crc32c_sse42 },
+    };
+    static void* resolved;
+    return ((Crc32cFn)android_cpuResolve(
+            kVariants, 1, (void*)android_simd_crc32c_table,
+            &resolved))(crc, buf, n);
+#else
+    /* 32-bit ARM exposes ANDROID_CPU_ARM_FEATURE_CRC32, but the arm
+     * kernel file is built with NEON flags only; ARMv8 phones run the
+     * 64-bit library anyway.
+     */
+    return android_simd_crc32c_table(crc, buf, n);
+#endif
+}
+
+// --------------------------------------------------------------------
+// AES-128
+// --------------------------------------------------------------------
+
+int android_simd_aes128_available(void) {
+#if defined(__aarch64__)
+    return (android_getCpuFeatures() & ANDROID_CPU_ARM64_FEATURE_AES) != 0;
+#elif defined(__i386__) || defined(__x86_64__)
+    return (android_getCpuFeatures() & ANDROID_CPU_X86_FEATURE_AES_NI) != 0;
+#else
+    return 0;
+#endif
+}
+
+/* The key schedule runs inside the per-ISA kernels, on the same AES
+ * hardware as the block rounds: a software expansion would feed secret
+ * key bytes through S-box table lookups, reintroducing for the key the
+ * very cache-timing channel the hardware paths exist to remove.
+ */
+int android_simd_aes128_ecb_encrypt(const uint8_t key[16], uint8_t* out,
+                                    const uint8_t* in, size_t nblocks) {
+    if (!android_simd_aes128_available()) {
+        return 0;
+    }
+#if defined(__aarch64__)
+    android_simd_aes128_ecb_arm64(key, out, in, nblocks);
+    return 1;
+#elif defined(__i386__) || defined(__x86_64__)
+    android_simd_aes128_ecb_aesni(key, out, in, nblocks);
+    return 1;
+#else
+    (void)key;
+    (void)out;
+    (void)in;
+    (void)nblocks;
+    return 0;
+#endif
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/* simdops: feature-dispatched SIMD memory and block-cipher kernels,
+ * layered on the cpufeatures library.
+ *
+ * Each entry point resolves its fastest eligible implementation once,
+ * through android_cpuResolve(), and caches the result; after the first
+ * call the dispatch overhead is one atomic load and an indirect call.
+ * Every function has a portable fallback, so callers never need their
+ * own feature checks -- with the single documented exception of the AES
+ * helper, where a software fallback would defeat its purpose.
+ */
+
+#pragma once
+
+#include <sys/cdefs.h>
+#include <stddef.h>
+#include <stdint.h>
+
+__BEGIN_DECLS
+
+/* Copy 'n' bytes from 'src' to 'dst', returning 'dst'. The regions
+ * must not overlap.
+ *
+ * On ARM this uses wide NEON/ASIMD transfers, sized for streaming
+ * through write-combined destinations such as uncached graphics
+ * buffers, where store width dominates throughput. On x86 it forwards
+ * to the libc memcpy, which is already vectorized there.
+ */
+extern void* android_simd_memcpy(void* dst, const void* src, size_t n);
+
+/* Update a CRC-32C (Castagnoli, polynomial 0x1EDC6F41) checksum with
+ * 'n' bytes from 'buf' and return the new value. Pass 0 as the initial
+ * 'crc' for a fresh checksum.
+ *
+ * Uses the ARMv8 CRC32 instructions (ANDROID_CPU_ARM64_FEATURE_CRC32)
+ * or SSE4.2 on x86 when available, and a table implementation
+ * otherwise. Note this is CRC-32C, the variant both instruction sets
+ * accelerate, not the zlib/IEEE polynomial.
+ */
+extern uint32_t android_simd_crc32c(uint32_t crc, const void* buf, size_t n);
+
+/* Return 1 when android_simd_aes128_ecb_encrypt() is hardware-backed
+ * on this device, 0 otherwise.
+ */
+extern int android_simd_aes128_available(void);
+
+/* Encrypt 'nblocks' 16-byte blocks from 'in' to 'out' with AES-128 in
+ * ECB mode under 'key'. 'in' and 'out' may be equal but must not
+ * otherwise overlap.
+ *
+ * Returns 1 on success. Returns 0 -- without touching 'out' -- when
+ * the CPU lacks AES instructions: a software fallback here would
+ * silently reintroduce the timing side channels the hardware paths
+ * exist to remove, so callers must keep their constant-time software
+ * path and treat 0 as "use it". ECB mode is a building block for
+ * higher-level modes (CTR, GCM), not an encryption scheme on its own.
+ */
+extern int android_simd_aes128_ecb_encrypt(const uint8_t key[16],
+                                           uint8_t* out,
+                                           const uint8_t* in,
+                                           size_t nblocks);
+
+__END_DECLS
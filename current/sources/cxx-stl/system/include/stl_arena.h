@@ -0,0 +1,144 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef __SGI_STL_INTERNAL_ARENA_H
+#define __SGI_STL_INTERNAL_ARENA_H
+
+#pragma GCC system_header
+
+/*
+ * arena<N>: a bump allocator over N bytes of in-place storage.
+ * allocate() is a pointer bump, reset() is O(1) and reclaims everything
+ * at once; there is no per-object deallocation, so destructors of
+ * arena-allocated objects must be run by the caller if they matter.
+ * Returns 0 when the arena is exhausted rather than falling back to
+ * the heap, so hot paths sized correctly never allocate.
+ */
+
+#include <cstddef>
+#include <new>
+
+#ifndef __STL_BEGIN_NAMESPACE
+#define __STL_BEGIN_NAMESPACE namespace std {
+#endif
+
+#ifndef __STL_END_NAMESPACE
+#define __STL_END_NAMESPACE   }
+#endif
+
+__STL_BEGIN_NAMESPACE
+
+template <size_t _Nm>
+class arena {
+ public:
+  arena() : __used_(0) {}
+
+  /* Raw allocation with explicit alignment, which must be a power of
+   * two.  Returns 0 if the request does not fit.
+   */
+  void* allocate(size_t __n, size_t __align) {
+    size_t __offset = (__used_ + __align - 1) & ~(__align - 1);
+    if (__n > _Nm - __offset || __offset > _Nm)
+      return 0;
+    __used_ = __offset + __n;
+    return __storage_ + __offset;
+  }
+
+  /* Typed allocation of __n default-constructed objects. */
+  template <class _Tp>
+  _Tp* allocate(size_t __n) {
+    void* __p = allocate(__n * sizeof(_Tp), __alignof__(_Tp));
+    if (__p == 0)
+      return 0;
+    _Tp* __first = static_cast<_Tp*>(__p);
+    for (size_t __i = 0; __i < __n; ++__i)
+      new (static_cast<void*>(__first + __i)) _Tp();
+    return __first;
+  }
+
+  /* Discard every allocation at once. */
+  void reset() { __used_ = 0; }
+
+  size_t used() const     { return __used_; }
+  size_t capacity() const { return _Nm; }
+
+ private:
+  size_t __used_;
+  char __storage_[_Nm] __attribute__((__aligned__(__alignof__(long double))));
+
+  arena(const arena&);
+  arena& operator=(const arena&);
+};
+
+/* Minimal allocator adapter so an arena can back allocator-aware
+ * containers.  deallocate() is a no-op; memory comes back via
+ * arena::reset().
+ */
+template <class _Tp, size_t _Nm>
+class arena_allocator {
+ public:
+  typedef _Tp    value_type;
+  typedef _Tp*   pointer;
+  typedef size_t size_type;
+
+  explicit arena_allocator(arena<_Nm>& __a) : __arena_(&__a) {}
+
+  template <class _Up>
+  arena_allocator(const arena_allocator<_Up, _Nm>& __x)
+    : __arena_(__x.__arena_) {}
+
+  _Tp* allocate(size_t __n) {
+    return static_cast<_Tp*>(
+        __arena_->allocate(__n * sizeof(_Tp), __alignof__(_Tp)));
+  }
+
+  void deallocate(_Tp*, size_t) {}
+
+  arena<_Nm>* __arena_;
+};
+
+template <class _Tp, class _Up, size_t _Nm>
+inline bool operator==(const arena_allocator<_Tp, _Nm>& __x,
+                       const arena_allocator<_Up, _Nm>& __y) {
+  return __x.__arena_ == __y.__arena_;
+}
+
+template <class _Tp, class _Up, size_t _Nm>
+inline bool operator!=(const arena_allocator<_Tp, _Nm>& __x,
+                       const arena_allocator<_Up, _Nm>& __y) {
+  return !(__x == __y);
+}
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_ARENA_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -0,0 +1,173 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef __SGI_STL_INTERNAL_FIXED_VECTOR_H
+#define __SGI_STL_INTERNAL_FIXED_VECTOR_H
+
+#pragma GCC system_header
+
+/*
+ * fixed_vector<T, N>: a vector with in-place storage for N elements and
+ * no heap allocation.  Intended for hot paths in code built against the
+ * system STL, which has no <vector>.  Capacity is fixed; push_back()
+ * past capacity is a no-op that returns false.  There are no checked
+ * accessors because this library is built without exceptions.
+ */
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#ifndef __STL_BEGIN_NAMESPACE
+#define __STL_BEGIN_NAMESPACE namespace std {
+#endif
+
+#ifndef __STL_END_NAMESPACE
+#define __STL_END_NAMESPACE   }
+#endif
+
+__STL_BEGIN_NAMESPACE
+
+template <class _Tp, size_t _Nm>
+class fixed_vector {
+ public:
+  typedef _Tp         value_type;
+  typedef _Tp*        iterator;
+  typedef const _Tp*  const_iterator;
+  typedef _Tp&        reference;
+  typedef const _Tp&  const_reference;
+  typedef size_t      size_type;
+
+  fixed_vector() : __size_(0) {}
+
+  fixed_vector(const fixed_vector& __x) : __size_(0) {
+    for (size_type __i = 0; __i < __x.__size_; ++__i)
+      push_back(__x[__i]);
+  }
+
+  fixed_vector& operator=(const fixed_vector& __x) {
+    if (this != &__x) {
+      clear();
+      for (size_type __i = 0; __i < __x.__size_; ++__i)
+        push_back(__x[__i]);
+    }
+    return *this;
+  }
+
+#if __cplusplus >= 201103L
+  fixed_vector(fixed_vector&& __x) : __size_(0) {
+    for (size_type __i = 0; __i < __x.__size_; ++__i)
+      push_back(move(__x[__i]));
+    __x.clear();
+  }
+
+  fixed_vector& operator=(fixed_vector&& __x) {
+    if (this != &__x) {
+      clear();
+      for (size_type __i = 0; __i < __x.__size_; ++__i)
+        push_back(move(__x[__i]));
+      __x.clear();
+    }
+    return *this;
+  }
+#endif
+
+  ~fixed_vector() { clear(); }
+
+  size_type size() const     { return __size_; }
+  size_type capacity() const { return _Nm; }
+  bool empty() const         { return __size_ == 0; }
+  bool full() const          { return __size_ == _Nm; }
+
+  iterator begin()             { return data(); }
+  const_iterator begin() const { return data(); }
+  iterator end()               { return data() + __size_; }
+  const_iterator end() const   { return data() + __size_; }
+
+  _Tp* data()             { return reinterpret_cast<_Tp*>(__storage_); }
+  const _Tp* data() const { return reinterpret_cast<const _Tp*>(__storage_); }
+
+  reference operator[](size_type __n)             { return data()[__n]; }
+  const_reference operator[](size_type __n) const { return data()[__n]; }
+
+  reference front()             { return data()[0]; }
+  const_reference front() const { return data()[0]; }
+  reference back()              { return data()[__size_ - 1]; }
+  const_reference back() const  { return data()[__size_ - 1]; }
+
+  bool push_back(const _Tp& __x) {
+    if (__size_ == _Nm)
+      return false;
+    new (static_cast<void*>(data() + __size_)) _Tp(__x);
+    ++__size_;
+    return true;
+  }
+
+#if __cplusplus >= 201103L
+  bool push_back(_Tp&& __x) {
+    if (__size_ == _Nm)
+      return false;
+    new (static_cast<void*>(data() + __size_)) _Tp(move(__x));
+    ++__size_;
+    return true;
+  }
+
+  template <class... _Args>
+  bool emplace_back(_Args&&... __args) {
+    if (__size_ == _Nm)
+      return false;
+    new (static_cast<void*>(data() + __size_)) _Tp(forward<_Args>(__args)...);
+    ++__size_;
+    return true;
+  }
+#endif
+
+  void pop_back() {
+    --__size_;
+    data()[__size_].~_Tp();
+  }
+
+  void clear() {
+    while (__size_ != 0)
+      pop_back();
+  }
+
+ private:
+  size_type __size_;
+  char __storage_[_Nm * sizeof(_Tp)]
+      __attribute__((__aligned__(__alignof__(_Tp))));
+};
+
+__STL_END_NAMESPACE
+
+#endif /* __SGI_STL_INTERNAL_FIXED_VECTOR_H */
+
+// Local Variables:
+// mode:C++
+// End:
@@ -66,8 +66,60 @@
 #define __STL_END_NAMESPACE   }
 #endif
 
+/* Keep the original copy-only definitions for pre-C++11 translation
+ * units; everything in the C++11 sections below is additive.
+ */
+#if __cplusplus >= 201103L
+#  define __STL_CONSTEXPR constexpr
+#else
+#  define __STL_CONSTEXPR
+#endif
+
 __STL_BEGIN_NAMESPACE
 
+#if __cplusplus >= 201103L
+
+/* This library has no <type_traits>, so provide the few internal traits
+ * that move support and the forwarding make_pair() need.
+ */
+template <class _Tp> struct __remove_reference        { typedef _Tp type; };
+template <class _Tp> struct __remove_reference<_Tp&>  { typedef _Tp type; };
+template <class _Tp> struct __remove_reference<_Tp&&> { typedef _Tp type; };
+
+template <class _Tp> struct __remove_cv                     { typedef _Tp type; };
+template <class _Tp> struct __remove_cv<const _Tp>          { typedef _Tp type; };
+template <class _Tp> struct __remove_cv<volatile _Tp>       { typedef _Tp type; };
+template <class _Tp> struct __remove_cv<const volatile _Tp> { typedef _Tp type; };
+
+template <class _Tp>
+struct __pair_decay {
+  typedef typename __remove_cv<typename __remove_reference<_Tp>::type>::type
+      type;
+};
+
+/* <utility> includes this header, so these provide std::move() and
+ * std::forward() for code built against the system STL.
+ */
+template <class _Tp>
+inline constexpr typename __remove_reference<_Tp>::type&&
+move(_Tp&& __t) noexcept {
+  return static_cast<typename __remove_reference<_Tp>::type&&>(__t);
+}
+
+template <class _Tp>
+inline constexpr _Tp&&
+forward(typename __remove_reference<_Tp>::type& __t) noexcept {
+  return static_cast<_Tp&&>(__t);
+}
+
+template <class _Tp>
+inline constexpr _Tp&&
+forward(typename __remove_reference<_Tp>::type&& __t) noexcept {
+  return static_cast<_Tp&&>(__t);
+}
+
+#endif /* __cplusplus >= 201103L */
+
 template <class _T1, class _T2>
 struct pair {
   typedef _T1 first_type;
@@ -75,52 +127,94 @@ struct pair {
 
   _T1 first;
   _T2 second;
-  pair() : first(), second() {}
-  pair(const _T1& __a, const _T2& __b) : first(__a), second(__b) {}
+  __STL_CONSTEXPR pair() : first(), second() {}
+  __STL_CONSTEXPR pair(const _T1& __a, const _T2& __b)
+    : first(__a), second(__b) {}
 
   template <class _U1, class _U2>
-  pair(const pair<_U1, _U2>& __p) : first(__p.first), second(__p.second) {}
+  __STL_CONSTEXPR pair(const pair<_U1, _U2>& __p)
+    : first(__p.first), second(__p.second) {}
+
+#if __cplusplus >= 201103L
+  pair(const pair&) = default;
+  pair(pair&&) = default;
+  pair& operator=(const pair&) = default;
+  pair& operator=(pair&&) = default;
+
+  template <class _U1, class _U2>
+  constexpr pair(_U1&& __a, _U2&& __b)
+    : first(forward<_U1>(__a)), second(forward<_U2>(__b)) {}
+
+  template <class _U1, class _U2>
+  constexpr pair(pair<_U1, _U2>&& __p)
+    : first(forward<_U1>(__p.first)), second(forward<_U2>(__p.second)) {}
+#endif
 };
 
 template <class _T1, class _T2>
-inline bool operator==(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y)
+inline __STL_CONSTEXPR bool
+operator==(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y)
 {
   return __x.first == __y.first && __x.second == __y.second;
 }
 
 template <class _T1, class _T2>
-inline bool operator<(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y)
+inline __STL_CONSTEXPR bool
+operator<(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y)
 {
   return __x.first < __y.first ||
          (!(__y.first < __x.first) && __x.second < __y.second);
 }
 
 template <class _T1, class _T2>
-inline bool operator!=(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
+inline __STL_CONSTEXPR bool
+operator!=(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
   return !(__x == __y);
 }
 
 template <class _T1, class _T2>
-inline bool operator>(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
+inline __STL_CONSTEXPR bool
+operator>(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
   return __y < __x;
 }
 
 template <class _T1, class _T2>
-inline bool operator<=(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
+inline __STL_CONSTEXPR bool
+operator<=(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
   return !(__y < __x);
 }
 
 template <class _T1, class _T2>
-inline bool operator>=(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
+inline __STL_CONSTEXPR bool
+operator>=(const pair<_T1, _T2>& __x, const pair<_T1, _T2>& __y) {
   return !(__x < __y);
 }
 
+#if __cplusplus >= 201103L
+
+/* Perfect-forwarding make_pair: arguments are moved, not copied, into
+ * the result.
+ */
+template <class _T1, class _T2>
+inline constexpr pair<typename __pair_decay<_T1>::type,
+                      typename __pair_decay<_T2>::type>
+make_pair(_T1&& __x, _T2&& __y)
+{
+  return pair<typename __pair_decay<_T1>::type,
+              typename __pair_decay<_T2>::type>(forward<_T1>(__x),
+                                                forward<_T2>(__y));
+}
+
+#else
+
 template <class _T1, class _T2>
 inline pair<_T1, _T2> make_pair(_T1 __x, _T2 __y)
 {
   return pair<_T1, _T2>(__x, __y);
 }
 
+#endif /* __cplusplus >= 201103L */
+
 __STL_END_NAMESPACE
 
 #endif /* __SGI_STL_INTERNAL_PAIR_H */